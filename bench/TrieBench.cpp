@@ -0,0 +1,311 @@
+// Benchmarks for the Trie hot paths across storage and children policies.
+//
+// Usage: trie_bench [--format json|csv] [--keys N] [--repeat R] [--seed S]
+//
+// Each workload runs R times on a fresh, identically seeded data set and the median
+// time is reported. Memory is the peak number of bytes requested from the node storage,
+// divided by the number of keys (allocator headers and pool slack are not included).
+// The direct layout needs about 13 KB per key; keep --keys moderate.
+// Build with -DCMAKE_BUILD_TYPE=Release for meaningful numbers.
+
+#include <Sefn/Trie.hpp>
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace {
+
+    // Forwards to Base and records the live and peak number of requested bytes
+    template<class Base>
+    class CountingStorage {
+    public:
+        static constexpr bool releasesInBulk = Base::releasesInBulk;
+
+        void* allocate(std::size_t bytes, std::size_t alignment) {
+            liveBytes += bytes;
+            peakBytes = std::max(peakBytes, liveBytes);
+            return base.allocate(bytes, alignment);
+        }
+
+        void deallocate(void* block, std::size_t bytes, std::size_t alignment) noexcept {
+            liveBytes -= bytes;
+            base.deallocate(block, bytes, alignment);
+        }
+
+        void release() noexcept {
+            liveBytes = 0;
+            base.release();
+        }
+
+        std::size_t peak() const {
+            return peakBytes;
+        }
+
+    private:
+        Base base;
+        std::size_t liveBytes = 0;
+        std::size_t peakBytes = 0;
+    };
+
+    template<class StoragePolicy, class ChildrenPolicy>
+    struct BenchTraits : Sefn::TrieTraits {
+        using Storage = CountingStorage<StoragePolicy>;
+        using Children = ChildrenPolicy;
+    };
+
+    struct Options {
+        std::string format = "json";
+        std::size_t keys = 50000;
+        std::size_t repeat = 5;
+        std::uint64_t seed = 42;
+    };
+
+    struct Result {
+        std::string layout;
+        std::string workload;
+        std::size_t operations;
+        double nsPerOp;
+        double bytesPerKey;
+    };
+
+    class Random {
+    public:
+        explicit Random(std::uint64_t seed) : state(seed ? seed : 1) {}
+
+        std::uint64_t next() {
+            state ^= state << 13;
+            state ^= state >> 7;
+            state ^= state << 17;
+            return state;
+        }
+
+        std::size_t below(std::size_t bound) {
+            return static_cast<std::size_t>(next() % bound);
+        }
+
+    private:
+        std::uint64_t state;
+    };
+
+    // Keys of length 4..16 over a skewed 26-letter alphabet, so prefixes are shared
+    std::vector<std::string> makeKeys(std::size_t count, Random& random) {
+        std::vector<std::string> keys;
+        keys.reserve(count);
+        while (keys.size() < count) {
+            std::string key(4 + random.below(13), 'a');
+            for (char& ch : key) {
+                std::size_t a = random.below(26), b = random.below(26);
+                ch = static_cast<char>('a' + std::min(a, b));
+            }
+            keys.push_back(std::move(key));
+        }
+        std::sort(keys.begin(), keys.end());
+        keys.erase(std::unique(keys.begin(), keys.end()), keys.end());
+        return keys;
+    }
+
+    volatile std::size_t sink = 0;
+
+    template<class Func>
+    double medianNs(std::size_t repeat, Func run) {
+        std::vector<double> samples;
+        for (std::size_t i = 0; i < repeat; ++i) {
+            auto start = std::chrono::steady_clock::now();
+            run();
+            auto stop = std::chrono::steady_clock::now();
+            samples.push_back(std::chrono::duration<double, std::nano>(stop - start).count());
+        }
+        std::sort(samples.begin(), samples.end());
+        return samples[samples.size() / 2];
+    }
+
+    template<class Traits>
+    void benchLayout(const std::string& layout, const Options& options,
+                     std::vector<Result>& results) {
+        using TrieType = Sefn::Trie<int, Traits>;
+
+        Random random(options.seed);
+        std::vector<std::string> sorted = makeKeys(options.keys, random);
+        std::vector<std::string> shuffled = sorted;
+        for (std::size_t i = shuffled.size(); i > 1; --i) {
+            std::swap(shuffled[i - 1], shuffled[random.below(i)]);
+        }
+        std::vector<std::string> missing;
+        for (const std::string& key : shuffled) {
+            missing.push_back(key + "#");
+        }
+        std::vector<std::pair<std::string_view, int*>> entries;
+        int value = 0;
+        for (const std::string& key : sorted) {
+            entries.emplace_back(key, &value);
+        }
+        std::vector<std::string> shortPrefixes, longPrefixes;
+        for (std::size_t i = 0; i < 256; ++i) {
+            const std::string& key = shuffled[i % shuffled.size()];
+            shortPrefixes.push_back(key.substr(0, 2));
+            longPrefixes.push_back(key.substr(0, 6));
+        }
+        const std::size_t n = sorted.size();
+
+        auto add = [&](const std::string& workload, std::size_t operations, double total,
+                       double bytesPerKey) {
+            results.push_back({layout, workload, operations, total / operations, bytesPerKey});
+        };
+
+        std::size_t peak = 0;
+        double time = medianNs(options.repeat, [&] {
+            TrieType trie;
+            for (const std::string& key : shuffled) {
+                trie.insert(&value, key);
+            }
+            peak = trie.getStorage()->peak();
+        });
+        add("insert_random", n, time, double(peak) / n);
+
+        time = medianNs(options.repeat, [&] {
+            TrieType trie;
+            for (const std::string& key : sorted) {
+                trie.insert(&value, key);
+            }
+            peak = trie.getStorage()->peak();
+        });
+        add("insert_sorted", n, time, double(peak) / n);
+
+        time = medianNs(options.repeat, [&] {
+            TrieType trie;
+            trie.buildFromSorted(entries.begin(), entries.end());
+            peak = trie.getStorage()->peak();
+        });
+        add("build_sorted", n, time, double(peak) / n);
+
+        TrieType trie;
+        trie.buildFromSorted(entries.begin(), entries.end());
+
+        time = medianNs(options.repeat, [&] {
+            std::size_t found = 0;
+            for (const std::string& key : shuffled) {
+                found += trie.wordExists(key) != nullptr;
+            }
+            sink = sink + found;
+        });
+        add("lookup_hit", n, time, 0);
+
+        time = medianNs(options.repeat, [&] {
+            std::size_t found = 0;
+            for (const std::string& key : missing) {
+                found += trie.wordExists(key) != nullptr;
+            }
+            sink = sink + found;
+        });
+        add("lookup_miss", n, time, 0);
+
+        std::vector<int*> batchResults(n);
+        time = medianNs(options.repeat, [&] {
+            trie.lookupBatch(shuffled.begin(), shuffled.end(), batchResults.begin());
+            sink = sink + static_cast<std::size_t>(batchResults[n / 2] != nullptr);
+        });
+        add("lookup_batch", n, time, 0);
+
+        time = medianNs(options.repeat, [&] {
+            std::size_t found = 0;
+            for (const std::string& prefix : shortPrefixes) {
+                found += trie.autoComplete(prefix, 100).size();
+            }
+            sink = sink + found;
+        });
+        add("autocomplete_short", shortPrefixes.size(), time, 0);
+
+        time = medianNs(options.repeat, [&] {
+            std::size_t found = 0;
+            for (const std::string& prefix : longPrefixes) {
+                found += trie.autoComplete(prefix).size();
+            }
+            sink = sink + found;
+        });
+        add("autocomplete_long", longPrefixes.size(), time, 0);
+
+        // Erase and reinsert every other key
+        time = medianNs(options.repeat, [&] {
+            for (std::size_t i = 0; i < n; i += 2) {
+                trie.erase(shuffled[i]);
+            }
+            for (std::size_t i = 0; i < n; i += 2) {
+                trie.insert(&value, shuffled[i]);
+            }
+        });
+        add("erase_churn", n, time, double(trie.getStorage()->peak()) / n);
+    }
+
+    bool parse(int argc, char** argv, Options& options) {
+        for (int i = 1; i < argc; ++i) {
+            std::string flag = argv[i];
+            if (i + 1 >= argc) {
+                return false;
+            }
+            std::string value = argv[++i];
+            if (flag == "--format" && (value == "json" || value == "csv")) {
+                options.format = value;
+            } else if (flag == "--keys") {
+                options.keys = std::strtoull(value.c_str(), nullptr, 10);
+            } else if (flag == "--repeat") {
+                options.repeat = std::strtoull(value.c_str(), nullptr, 10);
+            } else if (flag == "--seed") {
+                options.seed = std::strtoull(value.c_str(), nullptr, 10);
+            } else {
+                return false;
+            }
+        }
+        return options.keys > 0 && options.repeat > 0;
+    }
+
+    void print(const Options& options, const std::vector<Result>& results) {
+        if (options.format == "csv") {
+            std::cout << "layout,workload,operations,ns_per_op,bytes_per_key\n";
+            for (const Result& r : results) {
+                std::cout << r.layout << ',' << r.workload << ',' << r.operations << ','
+                          << r.nsPerOp << ',' << r.bytesPerKey << '\n';
+            }
+            return;
+        }
+        std::cout << "{\n  \"keys\": " << options.keys << ",\n  \"repeat\": " << options.repeat
+                  << ",\n  \"seed\": " << options.seed << ",\n  \"results\": [\n";
+        for (std::size_t i = 0; i < results.size(); ++i) {
+            const Result& r = results[i];
+            std::cout << "    {\"layout\": \"" << r.layout << "\", \"workload\": \"" << r.workload
+                      << "\", \"operations\": " << r.operations << ", \"ns_per_op\": " << r.nsPerOp
+                      << ", \"bytes_per_key\": " << r.bytesPerKey << '}'
+                      << (i + 1 < results.size() ? ",\n" : "\n");
+        }
+        std::cout << "  ]\n}\n";
+    }
+
+} // namespace
+
+int main(int argc, char** argv) {
+    Options options;
+    if (!parse(argc, argv, options)) {
+        std::cerr << "usage: trie_bench [--format json|csv] [--keys N] [--repeat R] [--seed S]\n";
+        return 2;
+    }
+
+    std::vector<Result> results;
+    benchLayout<BenchTraits<Sefn::HeapStorage, Sefn::MapChildren>>("heap/map", options, results);
+    benchLayout<BenchTraits<Sefn::PoolStorage, Sefn::MapChildren>>("pool/map", options, results);
+    benchLayout<Sefn::HashedTraits<BenchTraits<Sefn::PoolStorage, Sefn::MapChildren>>>(
+        "pool/map/hashed", options, results);
+    benchLayout<BenchTraits<Sefn::PoolStorage, Sefn::SortedVectorChildren>>("pool/sorted_vector",
+                                                                            options, results);
+    benchLayout<BenchTraits<Sefn::PoolStorage, Sefn::DirectChildren>>("pool/direct", options,
+                                                                      results);
+    benchLayout<BenchTraits<Sefn::PoolStorage, Sefn::AdaptiveChildren>>("pool/adaptive", options,
+                                                                        results);
+    print(options, results);
+    return 0;
+}
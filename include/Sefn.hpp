@@ -1,6 +1,16 @@
 #pragma once
 
+#include "Sefn/ConcurrentTrie.hpp"
+#include "Sefn/Dawg.hpp"
+#include "Sefn/FrozenTrie.hpp"
 #include "Sefn/InputUtils.hpp"
+#include "Sefn/KeyView.hpp"
+#include "Sefn/MappedFile.hpp"
+#include "Sefn/NodeStorage.hpp"
+#include "Sefn/PersistentTrie.hpp"
+#include "Sefn/RadixTrie.hpp"
+#include "Sefn/RankedTrie.hpp"
+#include "Sefn/StaticTrie.hpp"
 #include "Sefn/Trie.hpp"
 
 /**
@@ -8,6 +18,7 @@
  * @brief Main namespace for Sefn's C++ utilities and data structures.
  * 
  * This namespace contains all the core components of the library, including:
- * - Data structures (e.g., Trie)
+ * - Data structures (e.g., Trie, RadixTrie, RankedTrie, ConcurrentTrie, FrozenTrie,
+ *   PersistentTrie, Dawg, StaticTrie)
  * - Input validation utilities
  */
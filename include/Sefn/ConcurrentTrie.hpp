@@ -0,0 +1,606 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <mutex>
+#include <new>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include "KeyView.hpp"
+
+/**
+ * @file Sefn/ConcurrentTrie.hpp
+ * @brief Prefix tree with wait-free readers and epoch-based memory reclamation.
+ */
+
+namespace Sefn {
+
+    namespace detail {
+
+        /**
+         * @class EpochDomain
+         * @brief Process-wide epoch tracker used to defer freeing memory readers may still see.
+         *
+         * @details
+         * Each thread owns a record announcing the global epoch it observed when it started
+         * reading (or "idle"). Writers tag retired memory with the epoch current at unlink
+         * time and free it only once every active reader has announced a later epoch.
+         */
+        class EpochDomain {
+        public:
+            static constexpr std::uint64_t idle = std::numeric_limits<std::uint64_t>::max();
+
+            /**
+             * @brief Per-thread announcement slot.
+             */
+            struct alignas(64) Record {
+                std::atomic<std::uint64_t> epoch{idle};
+                std::atomic<bool> inUse{false};
+                Record* next = nullptr;
+                unsigned nesting = 0;
+            };
+
+            /**
+             * @brief RAII read-side critical section. Nested guards are allowed.
+             */
+            class Guard {
+            public:
+                Guard() : record(EpochDomain::instance().threadRecord()) {
+                    if (record->nesting++ == 0) {
+                        EpochDomain& domain = EpochDomain::instance();
+                        record->epoch.store(domain.global.load(std::memory_order_acquire),
+                                            std::memory_order_seq_cst);
+                        // Order the announcement before any load from the shared structure
+                        std::atomic_thread_fence(std::memory_order_seq_cst);
+                    }
+                }
+
+                ~Guard() {
+                    if (--record->nesting == 0) {
+                        record->epoch.store(idle, std::memory_order_release);
+                    }
+                }
+
+                Guard(const Guard&) = delete;
+                Guard& operator=(const Guard&) = delete;
+
+            private:
+                Record* record;
+            };
+
+            static EpochDomain& instance() {
+                static EpochDomain domain;
+                return domain;
+            }
+
+            /**
+             * @brief Advances the global epoch.
+             * @return The epoch that was current before the call; tag retired memory with it.
+             */
+            std::uint64_t advance() {
+                return global.fetch_add(1, std::memory_order_seq_cst);
+            }
+
+            /**
+             * @brief Smallest epoch announced by an active reader, or `idle` if none.
+             */
+            std::uint64_t minActive() const {
+                std::atomic_thread_fence(std::memory_order_seq_cst);
+                std::uint64_t minimum = idle;
+                for (Record* r = records.load(std::memory_order_acquire); r; r = r->next) {
+                    minimum = std::min(minimum, r->epoch.load(std::memory_order_seq_cst));
+                }
+                return minimum;
+            }
+
+            ~EpochDomain() {
+                Record* r = records.load(std::memory_order_acquire);
+                while (r) {
+                    Record* next = r->next;
+                    delete r;
+                    r = next;
+                }
+            }
+
+        private:
+            std::atomic<std::uint64_t> global{1};
+            std::atomic<Record*> records{nullptr};
+
+            /**
+             * @brief Returns a record to the pool when its thread exits.
+             */
+            struct ThreadSlot {
+                Record* record = nullptr;
+
+                ~ThreadSlot() {
+                    if (record) {
+                        record->epoch.store(idle, std::memory_order_release);
+                        record->inUse.store(false, std::memory_order_release);
+                    }
+                }
+            };
+
+            EpochDomain() = default;
+
+            /**
+             * @brief Record owned by the calling thread, claimed on first use.
+             */
+            Record* threadRecord() {
+                thread_local ThreadSlot slot;
+                if (!slot.record) {
+                    slot.record = claimRecord();
+                }
+                return slot.record;
+            }
+
+            Record* claimRecord() {
+                for (Record* r = records.load(std::memory_order_acquire); r; r = r->next) {
+                    bool expected = false;
+                    if (!r->inUse.load(std::memory_order_relaxed) &&
+                        r->inUse.compare_exchange_strong(expected, true)) {
+                        return r;
+                    }
+                }
+                Record* fresh = new Record;
+                fresh->inUse.store(true, std::memory_order_relaxed);
+                fresh->next = records.load(std::memory_order_relaxed);
+                while (!records.compare_exchange_weak(fresh->next, fresh,
+                                                      std::memory_order_release,
+                                                      std::memory_order_relaxed)) {
+                }
+                return fresh;
+            }
+        };
+
+    } // namespace detail
+
+    /**
+     * @class ConcurrentTrie
+     * @brief A Trie that many threads can read while one thread at a time modifies it.
+     *
+     * @details
+     * - Readers (find-style queries, traversal) never lock and never wait: each query is an
+     *   epoch announcement, a fence, and ordinary acquire loads down the tree.
+     * - Writers are serialized by an internal mutex. Child arrays are immutable once
+     *   published; a writer builds a new array and swaps it in with a release store.
+     * - Replaced arrays and pruned nodes are retired and freed only after every reader that
+     *   could still be looking at them has finished (epoch-based reclamation).
+     *
+     * @tparam T Type of object to associate with each word.
+     *
+     * @note Does not take ownership of T* pointers. A pointer returned to a reader may refer
+     *       to an object another thread has just erased; keeping the objects themselves alive
+     *       is the user's responsibility.
+     *
+     * @example
+     * ```cpp
+     * Sefn::ConcurrentTrie<Session> sessions;
+     * // writer thread
+     * sessions.insert(&s, "token-42");
+     * // any number of reader threads, no external lock
+     * if (auto* found = sessions.wordExists("token-42")) { ... }
+     * ```
+     */
+    template<class T>
+    class ConcurrentTrie {
+    private:
+        struct Node;
+
+        /**
+         * @brief Immutable sorted edge list: header, then Node* children[count], then keys.
+         */
+        struct Edges {
+            std::uint32_t count;
+
+            Node** children() {
+                return reinterpret_cast<Node**>(reinterpret_cast<char*>(this) + offset());
+            }
+            Node* const* children() const {
+                return reinterpret_cast<Node* const*>(reinterpret_cast<const char*>(this) + offset());
+            }
+            char* keys() {
+                return reinterpret_cast<char*>(children() + count);
+            }
+            const char* keys() const {
+                return reinterpret_cast<const char*>(children() + count);
+            }
+
+            static constexpr std::size_t offset() {
+                return (sizeof(Edges) + alignof(Node*) - 1) / alignof(Node*) * alignof(Node*);
+            }
+
+            static std::size_t bytes(std::size_t count) {
+                return offset() + count * (sizeof(Node*) + sizeof(char));
+            }
+
+            static Edges* create(std::size_t count) {
+                Edges* edges = static_cast<Edges*>(::operator new(bytes(count)));
+                edges->count = static_cast<std::uint32_t>(count);
+                return edges;
+            }
+
+            static void destroy(void* edges) {
+                ::operator delete(edges);
+            }
+
+            /**
+             * @brief Child for @p ch, or nullptr.
+             */
+            const Node* find(char ch) const {
+                const char* begin = keys();
+                const char* end = begin + count;
+                const char* it = std::lower_bound(begin, end, ch);
+                return it != end && *it == ch ? children()[it - begin] : nullptr;
+            }
+        };
+
+        struct Node {
+            std::atomic<T*> object{nullptr};
+            std::atomic<Edges*> edges{nullptr};
+
+            static void destroy(void* node) {
+                Node* self = static_cast<Node*>(node);
+                Edges::destroy(self->edges.load(std::memory_order_relaxed));
+                delete self;
+            }
+        };
+
+        struct Retired {
+            void* pointer;
+            void (*deleter)(void*);
+            std::uint64_t epoch;
+        };
+
+        Node* const root = new Node;
+
+        /**
+         * @brief Serializes writers.
+         */
+        mutable std::mutex writer;
+
+        /**
+         * @brief Memory unlinked by writers and waiting for readers to move on.
+         */
+        std::vector<Retired> retired;
+
+        /**
+         * @brief Number of leading entries of retired that already carry an epoch.
+         */
+        std::size_t sealed = 0;
+
+        /**
+         * @brief Number of retired entries that triggers a reclamation pass.
+         */
+        static constexpr std::size_t reclaimThreshold = 64;
+
+        static const Node* child(const Node* node, char ch) {
+            const Edges* edges = node->edges.load(std::memory_order_acquire);
+            return edges ? edges->find(ch) : nullptr;
+        }
+
+        const Node* find(KeyView prefix) const {
+            const Node* current = root;
+            for (char ch : prefix) {
+                current = child(current, ch);
+                if (!current) {
+                    return nullptr;
+                }
+            }
+            return current;
+        }
+
+        /**
+         * @brief Visits objects under @p start in lexicographic order until @p function returns false.
+         */
+        template<typename Func>
+        static void visitSubtree(const Node* start, Func& function) {
+            std::vector<const Node*> stack{start};
+            while (!stack.empty()) {
+                const Node* node = stack.back();
+                stack.pop_back();
+                if (T* object = node->object.load(std::memory_order_acquire)) {
+                    if (!function(object)) {
+                        return;
+                    }
+                }
+                if (const Edges* edges = node->edges.load(std::memory_order_acquire)) {
+                    for (std::size_t i = edges->count; i-- > 0;) {
+                        stack.push_back(edges->children()[i]);
+                    }
+                }
+            }
+        }
+
+        /**
+         * @brief Publishes a copy of @p parent's edges with @p ch -> @p node added.
+         */
+        void publishWith(Node* parent, char ch, Node* node) {
+            Edges* old = parent->edges.load(std::memory_order_relaxed);
+            std::size_t count = old ? old->count : 0;
+            Edges* edges = Edges::create(count + 1);
+            std::size_t position = old ? std::lower_bound(old->keys(), old->keys() + count, ch) -
+                                             old->keys()
+                                       : 0;
+            for (std::size_t i = 0, j = 0; i <= count; ++i) {
+                if (i == position) {
+                    edges->children()[i] = node;
+                    edges->keys()[i] = ch;
+                } else {
+                    edges->children()[i] = old->children()[j];
+                    edges->keys()[i] = old->keys()[j];
+                    ++j;
+                }
+            }
+            parent->edges.store(edges, std::memory_order_release);
+            if (old) {
+                retire(old, &Edges::destroy);
+            }
+        }
+
+        /**
+         * @brief Publishes a copy of @p parent's edges with @p ch removed.
+         */
+        void publishWithout(Node* parent, char ch) {
+            Edges* old = parent->edges.load(std::memory_order_relaxed);
+            Edges* edges = nullptr;
+            if (old->count > 1) {
+                edges = Edges::create(old->count - 1);
+                for (std::size_t i = 0, j = 0; i < old->count; ++i) {
+                    if (old->keys()[i] != ch) {
+                        edges->children()[j] = old->children()[i];
+                        edges->keys()[j] = old->keys()[i];
+                        ++j;
+                    }
+                }
+            }
+            parent->edges.store(edges, std::memory_order_release);
+            retire(old, &Edges::destroy);
+        }
+
+        /**
+         * @brief Queues unlinked memory; it is tagged with an epoch by the next seal().
+         */
+        void retire(void* pointer, void (*deleter)(void*)) {
+            retired.push_back({pointer, deleter, 0});
+        }
+
+        /**
+         * @brief Ends a write: tags everything retired by it with one epoch and maybe reclaims.
+         */
+        void seal() {
+            if (sealed == retired.size()) {
+                return;
+            }
+            std::uint64_t epoch = detail::EpochDomain::instance().advance();
+            for (std::size_t i = sealed; i < retired.size(); ++i) {
+                retired[i].epoch = epoch;
+            }
+            sealed = retired.size();
+            if (retired.size() >= reclaimThreshold) {
+                collect();
+            }
+        }
+
+        /**
+         * @brief Frees retired memory no active reader can still reach. Caller holds the writer lock.
+         */
+        void collect() {
+            std::uint64_t safeBefore = detail::EpochDomain::instance().minActive();
+            auto survivors = std::partition(retired.begin(), retired.end(),
+                [safeBefore](const Retired& r) { return r.epoch >= safeBefore; });
+            for (auto it = survivors; it != retired.end(); ++it) {
+                it->deleter(it->pointer);
+            }
+            retired.erase(survivors, retired.end());
+            sealed = retired.size();
+        }
+
+        /**
+         * @brief Retires every node below @p node (not @p node itself).
+         */
+        void retireDescendants(Node* node) {
+            std::vector<Node*> pending;
+            if (Edges* edges = node->edges.load(std::memory_order_relaxed)) {
+                pending.assign(edges->children(), edges->children() + edges->count);
+            }
+            while (!pending.empty()) {
+                Node* current = pending.back();
+                pending.pop_back();
+                if (Edges* edges = current->edges.load(std::memory_order_relaxed)) {
+                    pending.insert(pending.end(), edges->children(), edges->children() + edges->count);
+                }
+                retire(current, &Node::destroy);
+            }
+        }
+
+    public:
+        ConcurrentTrie() = default;
+        ConcurrentTrie(const ConcurrentTrie&) = delete;
+        ConcurrentTrie& operator=(const ConcurrentTrie&) = delete;
+
+        /**
+         * @brief Destructor. No reader or writer may use the Trie concurrently.
+         * @note This does NOT deallocate the `T* object` pointers.
+         */
+        ~ConcurrentTrie() {
+            std::vector<Node*> pending{root};
+            while (!pending.empty()) {
+                Node* current = pending.back();
+                pending.pop_back();
+                if (Edges* edges = current->edges.load(std::memory_order_relaxed)) {
+                    pending.insert(pending.end(), edges->children(), edges->children() + edges->count);
+                }
+                Node::destroy(current);
+            }
+            for (const Retired& r : retired) {
+                r.deleter(r.pointer);
+            }
+        }
+
+        /**
+         * @brief Inserts a word with an associated object. Serialized with other writers.
+         * @note Overwrites the object if the word already exists.
+         */
+        void insert(T *object, KeyView word) {
+            std::lock_guard<std::mutex> lock(writer);
+            Node* current = root;
+            std::size_t index = 0;
+            for (; index < word.size(); ++index) {
+                Node* next = const_cast<Node*>(child(current, word[index]));
+                if (!next) {
+                    break;
+                }
+                current = next;
+            }
+            if (index == word.size()) {
+                current->object.store(object, std::memory_order_release);
+                return;
+            }
+            // Build the missing chain privately, then publish it with a single store
+            Node* chain = new Node;
+            Node* tail = chain;
+            for (std::size_t i = index + 1; i < word.size(); ++i) {
+                Node* next = new Node;
+                Edges* edges = Edges::create(1);
+                edges->children()[0] = next;
+                edges->keys()[0] = word[i];
+                tail->edges.store(edges, std::memory_order_relaxed);
+                tail = next;
+            }
+            tail->object.store(object, std::memory_order_relaxed);
+            publishWith(current, word[index], chain);
+            seal();
+        }
+
+        /**
+         * @brief Removes a word and unlinks nodes it alone was using.
+         * @return True if the word was found and removed.
+         */
+        bool erase(KeyView word) {
+            std::lock_guard<std::mutex> lock(writer);
+            std::vector<Node*> path{root};
+            for (char ch : word) {
+                Node* next = const_cast<Node*>(child(path.back(), ch));
+                if (!next) {
+                    return false;
+                }
+                path.push_back(next);
+            }
+            if (!path.back()->object.load(std::memory_order_relaxed)) {
+                return false;
+            }
+            path.back()->object.store(nullptr, std::memory_order_release);
+
+            // A leaf without an object leads nowhere: unlink the chain of nodes above it that
+            // existed only for this word, with one store into the first ancestor that stays
+            std::size_t depth = word.size();
+            if (depth > 0 && !path[depth]->edges.load(std::memory_order_relaxed)) {
+                while (depth > 1 && !path[depth - 1]->object.load(std::memory_order_relaxed) &&
+                       path[depth - 1]->edges.load(std::memory_order_relaxed)->count == 1) {
+                    --depth;
+                }
+                publishWithout(path[depth - 1], word[depth - 1]);
+                retireDescendants(path[depth]);
+                retire(path[depth], &Node::destroy);
+            }
+            seal();
+            return true;
+        }
+
+        /**
+         * @brief Checks if a word exists and returns its associated object. Wait-free.
+         */
+        T* wordExists(KeyView word) {
+            return const_cast<T*>(static_cast<const ConcurrentTrie*>(this)->wordExists(word));
+        }
+
+        /**
+         * @brief Const overload of wordExists().
+         */
+        const T* wordExists(KeyView word) const {
+            detail::EpochDomain::Guard guard;
+            const Node* node = find(word);
+            return node ? node->object.load(std::memory_order_acquire) : nullptr;
+        }
+
+        /**
+         * @brief Checks if a prefix exists. Wait-free.
+         */
+        bool prefixExists(KeyView prefix) const {
+            detail::EpochDomain::Guard guard;
+            return find(prefix) != nullptr;
+        }
+
+        /**
+         * @brief Retrieves objects matching a prefix in lexicographic order.
+         * @details Sees a consistent view of each node, but concurrent writes may or may not
+         *          be reflected in the result.
+         */
+        std::vector<T*> autoComplete(KeyView prefix) const {
+            return autoComplete(prefix, std::numeric_limits<std::size_t>::max());
+        }
+
+        /**
+         * @brief Retrieves at most @p limit objects matching a prefix in lexicographic order.
+         */
+        std::vector<T*> autoComplete(KeyView prefix, std::size_t limit) const {
+            std::vector<T*> results;
+            detail::EpochDomain::Guard guard;
+            const Node* start = find(prefix);
+            if (start && limit > 0) {
+                auto collect = [&results, limit](T* obj) {
+                    results.push_back(obj);
+                    return results.size() < limit;
+                };
+                visitSubtree(start, collect);
+            }
+            return results;
+        }
+
+        /**
+         * @brief Applies a function to all objects in lexicographic order.
+         */
+        template<typename Func>
+        void traverse(Func function) const {
+            detail::EpochDomain::Guard guard;
+            auto step = [&function](T* obj) {
+                function(obj);
+                return true;
+            };
+            visitSubtree(root, step);
+        }
+
+        /**
+         * @brief Removes every word. Readers in flight keep seeing the old tree until they finish.
+         */
+        void clear() {
+            std::lock_guard<std::mutex> lock(writer);
+            root->object.store(nullptr, std::memory_order_release);
+            Edges* edges = root->edges.load(std::memory_order_relaxed);
+            if (!edges) {
+                return;
+            }
+            retireDescendants(root);
+            root->edges.store(nullptr, std::memory_order_release);
+            retire(edges, &Edges::destroy);
+            seal();
+        }
+
+        /**
+         * @brief Frees whatever retired memory is no longer visible to any reader.
+         * @details Runs automatically as writes accumulate garbage; call it to trim memory
+         *          after a burst of writes.
+         */
+        void reclaim() {
+            std::lock_guard<std::mutex> lock(writer);
+            collect();
+        }
+    };
+
+} // namespace Sefn
@@ -0,0 +1,490 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+#include "Trie.hpp"
+
+/**
+ * @file Sefn/Dawg.hpp
+ * @brief Minimized, pointer-free word graph (DAWG) compiled from sorted words or a Trie.
+ */
+
+namespace Sefn {
+
+    class DawgBuilder;
+
+    /**
+     * @class Dawg
+     * @brief Read-only set of words stored as a minimal deterministic acyclic automaton.
+     *
+     * @details A Trie shares prefixes; a DAWG also shares suffixes, so "walking", "talking"
+     * and "walked" end in the same states. The graph is held in two `std::uint32_t` arrays:
+     *
+     * - `states`: two entries per state, the index of its first edge and the number of words
+     *   accepted from it (bit 31 set if the state ends a word). A state's edges run up to the
+     *   first edge of the next state; a sentinel state closes the array.
+     * - `edges`: `target << 8 | label`, sorted like Trie's children.
+     *
+     * Shared states cannot carry a per-word value, but the word counts turn the graph into a
+     * minimal perfect hash: indexOf() returns the position of a word in key order (the order
+     * Trie iterates), and wordAt() inverts it. Values go in a separate array indexed that way.
+     *
+     * Limits: at most 2^24 states and 2^31 - 1 words; DawgBuilder::add() refuses words beyond
+     * them.
+     *
+     * @example
+     * ```cpp
+     * Sefn::Dawg stopWords = Sefn::compileDawg(trie);
+     * stopWords.wordExists("the");               // true
+     * std::size_t id = stopWords.indexOf("the"); // rank of "the" in key order
+     * ```
+     */
+    class Dawg {
+    public:
+        /**
+         * @brief Returned by indexOf() for absent words.
+         */
+        static constexpr std::size_t npos = static_cast<std::size_t>(-1);
+
+        /**
+         * @brief Creates an empty graph.
+         */
+        Dawg() = default;
+
+        /**
+         * @brief Number of words.
+         */
+        std::size_t size() const {
+            return states.empty() ? 0 : states[1] & ~finalBit;
+        }
+
+        bool empty() const {
+            return size() == 0;
+        }
+
+        /**
+         * @brief Number of states (the root included).
+         */
+        std::size_t stateCount() const {
+            return states.empty() ? 0 : states.size() / 2 - 1;
+        }
+
+        std::size_t edgeCount() const {
+            return edges.size();
+        }
+
+        /**
+         * @brief Bytes of the two arrays.
+         */
+        std::size_t memoryBytes() const {
+            return (states.capacity() + edges.capacity()) * sizeof(std::uint32_t);
+        }
+
+        /**
+         * @brief Checks if a word exists.
+         */
+        bool wordExists(KeyView word) const {
+            return indexOf(word) != npos;
+        }
+
+        /**
+         * @brief Position of @p word among all words in key order, or npos if it is absent.
+         */
+        std::size_t indexOf(KeyView word) const {
+            std::uint32_t state = 0;
+            std::size_t rank = 0;
+            if (!descend(word, state, rank) || !isFinal(state)) {
+                return npos;
+            }
+            return rank;
+        }
+
+        /**
+         * @brief The @p index-th word in key order. Requires `index < size()`.
+         */
+        std::string wordAt(std::size_t index) const {
+            std::string word;
+            std::uint32_t state = 0;
+            while (true) {
+                if (isFinal(state)) {
+                    if (index == 0) {
+                        return word;
+                    }
+                    --index;
+                }
+                for (std::uint32_t e = firstEdge(state);; ++e) {
+                    std::uint32_t target = targetOf(edges[e]);
+                    if (index < wordsFrom(target)) {
+                        word.push_back(labelOf(edges[e]));
+                        state = target;
+                        break;
+                    }
+                    index -= wordsFrom(target);
+                }
+            }
+        }
+
+        /**
+         * @brief Checks if any word starts with @p prefix.
+         */
+        bool prefixExists(KeyView prefix) const {
+            std::uint32_t state = 0;
+            std::size_t rank = 0;
+            return descend(prefix, state, rank);
+        }
+
+        /**
+         * @brief Applies a function to all words in lexicographic order.
+         */
+        template<typename Func>
+        void traverse(Func function) const {
+            forEachCompletion(KeyView(), [&function](std::string_view word, std::size_t) {
+                function(word);
+            });
+        }
+
+        /**
+         * @brief Retrieves all words starting with @p prefix, in lexicographic order.
+         */
+        std::vector<std::string> autoComplete(KeyView prefix) const {
+            std::vector<std::string> results;
+            forEachCompletion(prefix, [&results](std::string_view word, std::size_t) {
+                results.emplace_back(word);
+            });
+            return results;
+        }
+
+        /**
+         * @brief Retrieves at most @p limit words starting with @p prefix.
+         */
+        std::vector<std::string> autoComplete(KeyView prefix, std::size_t limit) const {
+            std::vector<std::string> results;
+            if (limit == 0) {
+                return results;
+            }
+            forEachCompletion(prefix, [&results, limit](std::string_view word, std::size_t) {
+                results.emplace_back(word);
+                return results.size() < limit;
+            });
+            return results;
+        }
+
+        /**
+         * @brief Streams the words starting with @p prefix, in lexicographic order.
+         * @param function Called with `(std::string_view word, std::size_t index)`, where
+         *        index is indexOf(word); may return bool, false stops the walk. The view is
+         *        only valid during the call.
+         * @return Number of words passed to @p function.
+         */
+        template<typename Func>
+        std::size_t forEachCompletion(KeyView prefix, Func function) const {
+            std::uint32_t state = 0;
+            std::size_t index = 0;
+            if (!descend(prefix, state, index)) {
+                return 0;
+            }
+            std::string word(prefix.begin(), prefix.end());
+            const std::size_t base = word.size();
+            std::size_t visited = 0;
+            // Pending (next, last) edge ranges, deepest last; frame k sits at depth k
+            std::vector<std::pair<std::uint32_t, std::uint32_t>> stack;
+            while (true) {
+                if (isFinal(state)) {
+                    ++visited;
+                    if (!invokeVisitor(function, std::string_view(word), index++)) {
+                        return visited;
+                    }
+                }
+                stack.push_back({firstEdge(state), firstEdge(state + 1)});
+                while (!stack.empty() && stack.back().first == stack.back().second) {
+                    stack.pop_back();
+                }
+                if (stack.empty()) {
+                    return visited;
+                }
+                std::uint32_t edge = edges[stack.back().first++];
+                word.resize(base + stack.size() - 1);
+                word.push_back(labelOf(edge));
+                state = targetOf(edge);
+            }
+        }
+
+    private:
+        friend class DawgBuilder;
+
+        static constexpr std::uint32_t finalBit = 0x80000000u;
+        static constexpr unsigned labelBits = 8;
+
+        std::vector<std::uint32_t> states;
+        std::vector<std::uint32_t> edges;
+
+        std::uint32_t firstEdge(std::uint32_t state) const {
+            return states[2 * state];
+        }
+
+        bool isFinal(std::uint32_t state) const {
+            return (states[2 * state + 1] & finalBit) != 0;
+        }
+
+        std::size_t wordsFrom(std::uint32_t state) const {
+            return states[2 * state + 1] & ~finalBit;
+        }
+
+        static char labelOf(std::uint32_t edge) {
+            return static_cast<char>(static_cast<unsigned char>(edge));
+        }
+
+        static std::uint32_t targetOf(std::uint32_t edge) {
+            return edge >> labelBits;
+        }
+
+        /**
+         * @brief Follows @p prefix from the root.
+         * @param state Receives the state reached.
+         * @param rank Receives the number of words that sort before every word with the prefix.
+         * @return False if no word starts with @p prefix.
+         */
+        bool descend(KeyView prefix, std::uint32_t& state, std::size_t& rank) const {
+            if (empty()) {
+                return false;
+            }
+            for (char ch : prefix) {
+                if (isFinal(state)) {
+                    ++rank;
+                }
+                std::uint32_t e = firstEdge(state);
+                const std::uint32_t last = firstEdge(state + 1);
+                while (e < last && labelOf(edges[e]) != ch) {
+                    rank += wordsFrom(targetOf(edges[e]));
+                    ++e;
+                }
+                if (e == last) {
+                    return false;
+                }
+                state = targetOf(edges[e]);
+            }
+            return true;
+        }
+
+        template<class Func>
+        static bool invokeVisitor(Func& function, std::string_view word, std::size_t index) {
+            if constexpr (std::is_void_v<
+                              std::invoke_result_t<Func&, std::string_view, std::size_t>>) {
+                function(word, index);
+                return true;
+            } else {
+                return static_cast<bool>(function(word, index));
+            }
+        }
+    };
+
+    /**
+     * @class DawgBuilder
+     * @brief Builds a minimized Dawg from words added in ascending order.
+     *
+     * @details Uses the incremental construction for sorted input (Daciuk et al.): the
+     * states of the previous word below its common prefix with the new one can no longer
+     * change, so each is replaced by an equivalent registered state (same finality, same
+     * labelled edges to the same targets) or registered itself. Building is a single pass and
+     * only the previous word's path is ever unminimized.
+     */
+    class DawgBuilder {
+    public:
+        DawgBuilder() : states(1), path{0} {}
+
+        /**
+         * @brief Appends a word.
+         * @return False (and nothing is added) if @p word does not sort after the previous
+         *         word, or if it would exceed the Dawg's state or word limits.
+         */
+        bool add(KeyView word) {
+            if (wordCount > 0 &&
+                !std::lexicographical_compare(previous.begin(), previous.end(),
+                                              word.begin(), word.end())) {
+                return false;
+            }
+            std::size_t common = 0;
+            std::size_t limit = std::min(previous.size(), word.size());
+            while (common < limit && previous[common] == word[common]) {
+                ++common;
+            }
+            // Live states bound the final state count from above
+            std::size_t live = states.size() - freeStates.size();
+            if (wordCount >= maxWords || live + (word.size() - common) > maxStates) {
+                return false;
+            }
+            minimizeBelow(common);
+            for (std::size_t i = common; i < word.size(); ++i) {
+                std::uint32_t child = newState();
+                states[path.back()].edges.push_back({word[i], child});
+                path.push_back(child);
+            }
+            states[path.back()].final = true;
+            previous.assign(word.data(), word.size());
+            ++wordCount;
+            return true;
+        }
+
+        /**
+         * @brief Number of words added so far.
+         */
+        std::size_t size() const {
+            return wordCount;
+        }
+
+        /**
+         * @brief Minimizes the remaining path and lays the graph out breadth-first.
+         *        The builder is empty afterwards.
+         */
+        Dawg finish() {
+            minimizeBelow(0);
+            countWords(states[0]);
+
+            constexpr std::uint32_t unnumbered = 0xFFFFFFFF;
+            std::vector<std::uint32_t> number(states.size(), unnumbered);
+            std::vector<std::uint32_t> order{0};
+            number[0] = 0;
+            std::size_t edgeTotal = 0;
+            for (std::size_t i = 0; i < order.size(); ++i) {
+                for (const auto& edge : states[order[i]].edges) {
+                    if (number[edge.second] == unnumbered) {
+                        number[edge.second] = static_cast<std::uint32_t>(order.size());
+                        order.push_back(edge.second);
+                    }
+                }
+                edgeTotal += states[order[i]].edges.size();
+            }
+
+            Dawg result;
+            result.states.reserve(2 * (order.size() + 1));
+            result.edges.reserve(edgeTotal);
+            for (std::uint32_t id : order) {
+                const BuildState& state = states[id];
+                result.states.push_back(static_cast<std::uint32_t>(result.edges.size()));
+                result.states.push_back(state.words | (state.final ? Dawg::finalBit : 0));
+                for (const auto& edge : state.edges) {
+                    result.edges.push_back(number[edge.second] << Dawg::labelBits |
+                                           static_cast<unsigned char>(edge.first));
+                }
+            }
+            result.states.push_back(static_cast<std::uint32_t>(result.edges.size()));
+            result.states.push_back(0);
+
+            *this = DawgBuilder();
+            return result;
+        }
+
+    private:
+        static constexpr std::size_t maxStates = std::size_t(1) << (32 - Dawg::labelBits);
+        static constexpr std::size_t maxWords = Dawg::finalBit - 1;
+
+        struct BuildState {
+            std::vector<std::pair<char, std::uint32_t>> edges;
+            std::uint32_t words = 0;
+            bool final = false;
+        };
+
+        std::vector<BuildState> states;
+
+        /**
+         * @brief Unregistered states along the previous word, root first.
+         */
+        std::vector<std::uint32_t> path;
+
+        /**
+         * @brief Registered states by signature (finality, then label and target per edge).
+         */
+        std::unordered_map<std::string, std::uint32_t> registry;
+
+        /**
+         * @brief Slots of states that were merged into an equivalent one.
+         */
+        std::vector<std::uint32_t> freeStates;
+
+        std::string previous;
+        std::size_t wordCount = 0;
+
+        std::uint32_t newState() {
+            if (!freeStates.empty()) {
+                std::uint32_t id = freeStates.back();
+                freeStates.pop_back();
+                return id;
+            }
+            states.emplace_back();
+            return static_cast<std::uint32_t>(states.size() - 1);
+        }
+
+        void countWords(BuildState& state) const {
+            state.words = state.final ? 1 : 0;
+            for (const auto& edge : state.edges) {
+                state.words += states[edge.second].words;
+            }
+        }
+
+        static std::string signatureOf(const BuildState& state) {
+            std::string signature(1, state.final ? '\1' : '\0');
+            signature.reserve(1 + state.edges.size() * (1 + sizeof(std::uint32_t)));
+            for (const auto& edge : state.edges) {
+                signature.push_back(edge.first);
+                signature.append(reinterpret_cast<const char*>(&edge.second),
+                                 sizeof(edge.second));
+            }
+            return signature;
+        }
+
+        /**
+         * @brief Replaces or registers the path states deeper than @p depth, deepest first,
+         *        and truncates the path to them.
+         */
+        void minimizeBelow(std::size_t depth) {
+            while (path.size() > depth + 1) {
+                std::uint32_t child = path.back();
+                path.pop_back();
+                auto [found, added] = registry.try_emplace(signatureOf(states[child]), child);
+                if (added) {
+                    countWords(states[child]);
+                } else {
+                    states[path.back()].edges.back().second = found->second;
+                    states[child] = BuildState();
+                    freeStates.push_back(child);
+                }
+            }
+        }
+    };
+
+    /**
+     * @brief Compiles the words of @p trie into a minimized Dawg.
+     * @details `dawg.indexOf(word)` is the word's position in @p trie's iteration order, so
+     *          values can be collected into an array by the same loop.
+     * @throws std::length_error If the words exceed the Dawg's state or word limits.
+     *
+     * @example
+     * ```cpp
+     * Sefn::Dawg words = Sefn::compileDawg(dictionary);
+     * std::vector<Entry*> entries;
+     * for (auto [key, entry] : dictionary) entries.push_back(entry);
+     * Entry* apple = entries[words.indexOf("apple")];
+     * ```
+     */
+    template<class T, class Traits>
+    Dawg compileDawg(const Trie<T, Traits>& trie) {
+        static_assert(std::is_same_v<typename Traits::Key, char>,
+                      "compileDawg() requires char keys");
+        DawgBuilder builder;
+        for (const auto& entry : trie) {
+            if (!builder.add(entry.first)) {
+                throw std::length_error("compileDawg(): Trie exceeds the Dawg limits");
+            }
+        }
+        return builder.finish();
+    }
+
+} // namespace Sefn
@@ -0,0 +1,505 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include "Trie.hpp"
+
+/**
+ * @file Sefn/FrozenTrie.hpp
+ * @brief Immutable, pointer-free Trie image that can be memory-mapped and queried in place.
+ */
+
+namespace Sefn {
+
+    namespace detail {
+
+        /**
+         * @brief Leading block of a frozen image. All offsets are in bytes from the image start.
+         */
+        struct FrozenHeader {
+            char magic[8];
+            std::uint32_t version;
+            std::uint32_t byteOrder;
+            std::uint32_t payloadSize;
+            std::uint32_t payloadAlignment;
+            std::uint32_t nodeCount;
+            std::uint32_t wordCount;
+            std::uint64_t nodesOffset;
+            std::uint64_t labelsOffset;
+            std::uint64_t payloadsOffset;
+            std::uint64_t totalSize;
+        };
+
+        /**
+         * @brief Node record. Nodes are stored in breadth-first order, so the children of a
+         *        node are the consecutive records `[firstChild, firstChild + childCount)`.
+         */
+        struct FrozenNode {
+            std::uint32_t firstChild;
+            std::uint32_t childCount;
+            std::uint32_t payload;
+        };
+
+        constexpr char frozenMagic[8] = {'S', 'E', 'F', 'N', 'F', 'R', 'Z', '\0'};
+        constexpr std::uint32_t frozenVersion = 1;
+        constexpr std::uint32_t frozenByteOrder = 0x01020304;
+        constexpr std::uint32_t frozenNoPayload = 0xFFFFFFFF;
+
+        /**
+         * @brief Alignment of every section of the image.
+         */
+        template<class Payload>
+        constexpr std::size_t frozenAlignment() {
+            return std::max<std::size_t>({alignof(FrozenHeader), alignof(FrozenNode),
+                                          alignof(Payload), 16});
+        }
+
+        constexpr std::uint64_t alignUp(std::uint64_t offset, std::size_t alignment) {
+            return (offset + alignment - 1) / alignment * alignment;
+        }
+
+        /**
+         * @brief True if `[offset, offset + bytes)` ends at or before @p limit, without
+         *        overflowing on huge offsets.
+         */
+        constexpr bool frozenFits(std::uint64_t offset, std::uint64_t bytes, std::uint64_t limit) {
+            return offset <= limit && bytes <= limit - offset;
+        }
+
+    } // namespace detail
+
+    /**
+     * @class FrozenTrieBuilder
+     * @brief Builds a FrozenTrie image from keys added in ascending order.
+     *
+     * @details Keys must arrive in the order Trie iterates them (lexicographic by `char`).
+     * Each key shares the nodes of its common prefix with the previous one, so building is a
+     * single pass over the input. The image is laid out breadth-first: nodes are 12-byte
+     * records, edge labels form one byte array and payloads are stored in key order.
+     *
+     * @tparam Payload Trivially copyable value stored per key (an index, an id, a small struct).
+     */
+    template<class Payload>
+    class FrozenTrieBuilder {
+        static_assert(std::is_trivially_copyable_v<Payload>,
+                      "FrozenTrie payloads are copied byte-wise and must be trivially copyable");
+
+    public:
+        FrozenTrieBuilder() : nodes(1), path{0} {}
+
+        /**
+         * @brief Appends a key and its payload.
+         * @return False (and nothing is added) if @p key does not sort after the previous key.
+         */
+        bool add(KeyView key, const Payload& payload) {
+            if (!payloads.empty() &&
+                !std::lexicographical_compare(previous.begin(), previous.end(),
+                                              key.begin(), key.end())) {
+                return false;
+            }
+            std::size_t common = 0;
+            std::size_t limit = std::min(previous.size(), key.size());
+            while (common < limit && previous[common] == key[common]) {
+                ++common;
+            }
+            path.resize(common + 1);
+            for (std::size_t i = common; i < key.size(); ++i) {
+                auto child = static_cast<std::uint32_t>(nodes.size());
+                nodes.emplace_back();
+                nodes[path.back()].children.push_back({key[i], child});
+                path.push_back(child);
+            }
+            nodes[path.back()].payload = static_cast<std::uint32_t>(payloads.size());
+            payloads.push_back(payload);
+            previous.assign(key.data(), key.size());
+            return true;
+        }
+
+        /**
+         * @brief Number of keys added so far.
+         */
+        std::size_t size() const {
+            return payloads.size();
+        }
+
+        /**
+         * @brief Serializes the added keys into a self-contained image.
+         */
+        std::vector<char> finish() const {
+            constexpr std::size_t alignment = detail::frozenAlignment<Payload>();
+
+            // Breadth-first numbering keeps siblings adjacent
+            std::vector<std::uint32_t> order{0};
+            order.reserve(nodes.size());
+            for (std::size_t i = 0; i < order.size(); ++i) {
+                for (const auto& edge : nodes[order[i]].children) {
+                    order.push_back(edge.second);
+                }
+            }
+
+            detail::FrozenHeader header{};
+            std::memcpy(header.magic, detail::frozenMagic, sizeof(header.magic));
+            header.version = detail::frozenVersion;
+            header.byteOrder = detail::frozenByteOrder;
+            header.payloadSize = sizeof(Payload);
+            header.payloadAlignment = alignof(Payload);
+            header.nodeCount = static_cast<std::uint32_t>(order.size());
+            header.wordCount = static_cast<std::uint32_t>(payloads.size());
+            header.nodesOffset = detail::alignUp(sizeof(header), alignment);
+            header.labelsOffset = detail::alignUp(
+                header.nodesOffset + order.size() * sizeof(detail::FrozenNode), alignment);
+            header.payloadsOffset = detail::alignUp(header.labelsOffset + order.size(), alignment);
+            header.totalSize = header.payloadsOffset + payloads.size() * sizeof(Payload);
+
+            std::vector<char> image(static_cast<std::size_t>(header.totalSize));
+            std::memcpy(image.data(), &header, sizeof(header));
+            char* nodeBytes = image.data() + header.nodesOffset;
+            char* labels = image.data() + header.labelsOffset;
+            std::uint32_t nextChild = 1;
+            for (std::size_t i = 0; i < order.size(); ++i) {
+                const BuildNode& source = nodes[order[i]];
+                detail::FrozenNode record{nextChild,
+                                          static_cast<std::uint32_t>(source.children.size()),
+                                          source.payload};
+                std::memcpy(nodeBytes + i * sizeof(record), &record, sizeof(record));
+                for (const auto& edge : source.children) {
+                    labels[nextChild++] = edge.first;
+                }
+            }
+            if (!payloads.empty()) {
+                std::memcpy(image.data() + header.payloadsOffset, payloads.data(),
+                            payloads.size() * sizeof(Payload));
+            }
+            return image;
+        }
+
+        /**
+         * @brief Serializes the added keys and writes the image to @p fileName.
+         * @return True if the file was written completely.
+         */
+        bool finish(const std::string& fileName) const {
+            std::vector<char> image = finish();
+            std::ofstream out(fileName, std::ios::binary | std::ios::trunc);
+            out.write(image.data(), static_cast<std::streamsize>(image.size()));
+            return static_cast<bool>(out.flush());
+        }
+
+    private:
+        struct BuildNode {
+            std::vector<std::pair<char, std::uint32_t>> children;
+            std::uint32_t payload = detail::frozenNoPayload;
+        };
+
+        std::vector<BuildNode> nodes;
+
+        /**
+         * @brief Nodes along the previous key, root first.
+         */
+        std::vector<std::uint32_t> path;
+
+        std::string previous;
+        std::vector<Payload> payloads;
+    };
+
+    /**
+     * @brief Freezes @p trie into an image, mapping each object to a payload.
+     * @param trie Trie to freeze.
+     * @param toPayload Callable `Payload(T*)` invoked once per word in key order.
+     *
+     * @example
+     * ```cpp
+     * std::uint32_t next = 0;
+     * auto image = Sefn::freeze<std::uint32_t>(dictionary, [&](Entry*) { return next++; });
+     * ```
+     */
+    template<class Payload, class T, class Traits, class Func>
+    std::vector<char> freeze(const Trie<T, Traits>& trie, Func toPayload) {
+        static_assert(std::is_same_v<typename Traits::Key, char>, "freeze() requires char keys");
+        FrozenTrieBuilder<Payload> builder;
+        for (auto [key, object] : trie) {
+            builder.add(key, toPayload(object));
+        }
+        return builder.finish();
+    }
+
+    /**
+     * @class FrozenTrie
+     * @brief Read-only view over a frozen image, queried without deserialization.
+     *
+     * @details open() checks the header and walks the node table once, so a truncated or
+     * corrupted image is refused instead of read out of bounds; openTrusted() skips the walk
+     * for images known to be intact. Node records are then read in place from the supplied
+     * bytes, which must stay alive (and unmodified) while the view is used.
+     * Images are only portable between machines of the same byte order, which open() checks.
+     *
+     * @tparam Payload Payload type the image was built with.
+     *
+     * @example
+     * ```cpp
+     * Sefn::MappedFile file("dictionary.bin");
+     * Sefn::FrozenTrie<std::uint32_t> dictionary(file.data(), file.size());
+     * if (const std::uint32_t* id = dictionary.wordExists("apple")) { ... }
+     * ```
+     */
+    template<class Payload>
+    class FrozenTrie {
+        static_assert(std::is_trivially_copyable_v<Payload>,
+                      "FrozenTrie payloads are copied byte-wise and must be trivially copyable");
+
+    public:
+        /**
+         * @brief Creates a closed, empty view.
+         */
+        FrozenTrie() = default;
+
+        /**
+         * @brief Opens a view over @p size bytes at @p data. Check isOpen() for success.
+         */
+        FrozenTrie(const void* data, std::size_t size) {
+            open(data, size);
+        }
+
+        /**
+         * @brief Points the view at a new image.
+         * @details Besides the header, every node record is checked: its children must be the
+         *          next unclaimed records (the breadth-first layout the builder writes, which
+         *          also rules out cycles) and its payload index must be below the word count.
+         *          This reads the whole node table, O(nodes).
+         * @param data Image start; must be aligned as the image sections are (mmap and
+         *             `std::vector<char>` storage both are).
+         * @param size Image size in bytes.
+         * @return False if the header is missing, foreign or inconsistent, or a node record is
+         *         malformed; the view is then closed and answers every query as empty.
+         */
+        bool open(const void* data, std::size_t size) {
+            if (!openTrusted(data, size)) {
+                return false;
+            }
+            // Records claimed by a parent so far (and the root); each record must be claimed
+            // before it is reached, so children always come after their parent
+            std::uint64_t claimed = 1;
+            for (std::uint64_t i = 0; i < nodeCount; ++i) {
+                const detail::FrozenNode& node = nodes[i];
+                if (i >= claimed ||
+                    (node.payload != detail::frozenNoPayload && node.payload >= wordCount) ||
+                    (node.childCount > 0 &&
+                     (node.firstChild != claimed || node.childCount > nodeCount - claimed))) {
+                    close();
+                    return false;
+                }
+                claimed += node.childCount;
+            }
+            if (claimed != nodeCount) {
+                close();
+                return false;
+            }
+            return true;
+        }
+
+        /**
+         * @brief Like open(), but only checks the header and trusts the node records.
+         * @details O(1) and touches no page beyond the header, for images this process
+         *          wrote or verified before. A corrupted node table makes queries read out
+         *          of bounds.
+         */
+        bool openTrusted(const void* data, std::size_t size) {
+            close();
+            constexpr std::size_t alignment = detail::frozenAlignment<Payload>();
+            const char* bytes = static_cast<const char*>(data);
+            if (!bytes || size < sizeof(detail::FrozenHeader) ||
+                reinterpret_cast<std::uintptr_t>(bytes) % alignof(detail::FrozenNode) != 0) {
+                return false;
+            }
+            detail::FrozenHeader header;
+            std::memcpy(&header, bytes, sizeof(header));
+            if (std::memcmp(header.magic, detail::frozenMagic, sizeof(header.magic)) != 0 ||
+                header.version != detail::frozenVersion ||
+                header.byteOrder != detail::frozenByteOrder ||
+                header.payloadSize != sizeof(Payload) ||
+                header.payloadAlignment != alignof(Payload) || header.nodeCount == 0 ||
+                header.totalSize > size ||
+                header.nodesOffset % alignment != 0 || header.payloadsOffset % alignment != 0 ||
+                header.nodesOffset < sizeof(header) ||
+                !detail::frozenFits(header.nodesOffset,
+                                    std::uint64_t(header.nodeCount) * sizeof(detail::FrozenNode),
+                                    header.labelsOffset) ||
+                !detail::frozenFits(header.labelsOffset, header.nodeCount,
+                                    header.payloadsOffset) ||
+                !detail::frozenFits(header.payloadsOffset,
+                                    std::uint64_t(header.wordCount) * sizeof(Payload),
+                                    header.totalSize) ||
+                reinterpret_cast<std::uintptr_t>(bytes + header.payloadsOffset) %
+                        alignof(Payload) != 0) {
+                return false;
+            }
+            nodes = reinterpret_cast<const detail::FrozenNode*>(bytes + header.nodesOffset);
+            labels = bytes + header.labelsOffset;
+            payloads = reinterpret_cast<const Payload*>(bytes + header.payloadsOffset);
+            nodeCount = header.nodeCount;
+            wordCount = header.wordCount;
+            return true;
+        }
+
+        /**
+         * @brief Detaches the view from its image.
+         */
+        void close() {
+            nodes = nullptr;
+            labels = nullptr;
+            payloads = nullptr;
+            nodeCount = 0;
+            wordCount = 0;
+        }
+
+        bool isOpen() const {
+            return nodes != nullptr;
+        }
+
+        /**
+         * @brief Number of words in the image.
+         */
+        std::size_t size() const {
+            return wordCount;
+        }
+
+        /**
+         * @brief Payload of the @p index-th word in key order.
+         */
+        const Payload& payloadAt(std::size_t index) const {
+            return payloads[index];
+        }
+
+        /**
+         * @brief Checks if a word exists and returns its payload.
+         * @return Pointer into the image, or nullptr if the word is absent.
+         */
+        const Payload* wordExists(KeyView word) const {
+            const detail::FrozenNode* node = find(word);
+            return node ? payloadOf(*node) : nullptr;
+        }
+
+        /**
+         * @brief Checks if any word starts with @p prefix.
+         */
+        bool prefixExists(KeyView prefix) const {
+            return find(prefix) != nullptr;
+        }
+
+        /**
+         * @brief Applies a function to all payloads in lexicographic order of their keys.
+         */
+        template<typename Func>
+        void traverse(Func function) const {
+            forEachCompletion(KeyView(), [&function](const Payload& payload) {
+                function(payload);
+            });
+        }
+
+        /**
+         * @brief Retrieves all payloads whose keys start with @p prefix, in lexicographic order.
+         */
+        std::vector<const Payload*> autoComplete(KeyView prefix) const {
+            std::vector<const Payload*> results;
+            forEachCompletion(prefix, [&results](const Payload& payload) {
+                results.push_back(&payload);
+            });
+            return results;
+        }
+
+        /**
+         * @brief Retrieves at most @p limit payloads whose keys start with @p prefix.
+         */
+        std::vector<const Payload*> autoComplete(KeyView prefix, std::size_t limit) const {
+            std::vector<const Payload*> results;
+            if (limit == 0) {
+                return results;
+            }
+            forEachCompletion(prefix, [&results, limit](const Payload& payload) {
+                results.push_back(&payload);
+                return results.size() < limit;
+            });
+            return results;
+        }
+
+        /**
+         * @brief Streams the payloads whose keys start with @p prefix, in lexicographic order.
+         * @param function Called with `const Payload&`; may return bool, false stops the walk.
+         * @return Number of payloads passed to @p function.
+         */
+        template<typename Func>
+        std::size_t forEachCompletion(KeyView prefix, Func function) const {
+            const detail::FrozenNode* start = find(prefix);
+            if (!start) {
+                return 0;
+            }
+            std::size_t visited = 0;
+            // Pending (next, last) node index ranges, deepest last
+            std::vector<std::pair<std::uint32_t, std::uint32_t>> stack;
+            const detail::FrozenNode* node = start;
+            while (true) {
+                if (const Payload* payload = payloadOf(*node)) {
+                    ++visited;
+                    if (!invokeVisitor(function, *payload)) {
+                        return visited;
+                    }
+                }
+                if (node->childCount > 0) {
+                    stack.push_back({node->firstChild, node->firstChild + node->childCount});
+                }
+                while (!stack.empty() && stack.back().first == stack.back().second) {
+                    stack.pop_back();
+                }
+                if (stack.empty()) {
+                    return visited;
+                }
+                node = &nodes[stack.back().first++];
+            }
+        }
+
+    private:
+        const detail::FrozenNode* nodes = nullptr;
+        const char* labels = nullptr;
+        const Payload* payloads = nullptr;
+        std::size_t nodeCount = 0;
+        std::size_t wordCount = 0;
+
+        const Payload* payloadOf(const detail::FrozenNode& node) const {
+            return node.payload == detail::frozenNoPayload ? nullptr : &payloads[node.payload];
+        }
+
+        const detail::FrozenNode* find(KeyView prefix) const {
+            if (!isOpen()) {
+                return nullptr;
+            }
+            const detail::FrozenNode* current = nodes;
+            for (char ch : prefix) {
+                const char* siblings = labels + current->firstChild;
+                std::size_t i = detail::findPosition(siblings, current->childCount, ch);
+                if (i == current->childCount) {
+                    return nullptr;
+                }
+                current = &nodes[current->firstChild + i];
+            }
+            return current;
+        }
+
+        template<class Func>
+        static bool invokeVisitor(Func& function, const Payload& payload) {
+            if constexpr (std::is_void_v<std::invoke_result_t<Func&, const Payload&>>) {
+                function(payload);
+                return true;
+            } else {
+                return static_cast<bool>(function(payload));
+            }
+        }
+    };
+
+} // namespace Sefn
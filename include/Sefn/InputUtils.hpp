@@ -1,9 +1,17 @@
 #pragma once
 
+#include <charconv>
+#include <cstddef>
+#include <functional>
 #include <iostream>
+#include <optional>
 #include <sstream>
 #include <string>
-#include <functional>
+#include <string_view>
+#include <system_error>
+#include <type_traits>
+#include <utility>
+#include <vector>
 
 /**
  * @file Sefn/InputUtils.hpp
@@ -11,12 +19,275 @@
  */
 
 namespace Sefn {
+
+    namespace detail {
+
+#if defined(__cpp_lib_to_chars)
+        constexpr bool floatingFromChars = true;
+#else
+        constexpr bool floatingFromChars = false;  // Floating-point from_chars not shipped yet
+#endif
+
+        /**
+         * @brief Characters `operator>>` skips in the classic locale.
+         */
+        constexpr bool isStreamSpace(char ch) {
+            return ch == ' ' || ch == '\t' || ch == '\n' || ch == '\v' || ch == '\f' ||
+                   ch == '\r';
+        }
+
+        /**
+         * @brief Parses @p line into @p value with the acceptance rule shared by every
+         *        readValidatedInput overload and the bulk readers: `std::stringstream(line) >>
+         *        value` must succeed and reach the end of the line.
+         *
+         * @details Arithmetic types go through std::from_chars (no stream, no allocation).
+         * Streams also accept a leading '+', which is skipped here to match; `inf`/`nan`
+         * are rejected because streams reject them. `std::string` takes the single
+         * whitespace-free token; other types use a stream. Two deliberate differences: a '-'
+         * in front of an unsigned value is a format error (streams wrap it around), and a
+         * character type accepts a line holding one non-space character (extracting a char
+         * never sets eof, so the stream rule alone would reject every line).
+         *
+         * @param valueStart Receives the offset of the value (after leading whitespace).
+         * @return `std::string_view::npos` on success, otherwise the offset of the first
+         *         character that is not part of a valid value.
+         */
+        template<typename T>
+        std::size_t parseLine(std::string_view line, T& value, std::size_t& valueStart) {
+            std::size_t start = 0;
+            while (start < line.size() && isStreamSpace(line[start])) {
+                ++start;
+            }
+            valueStart = start;
+            const char* first = line.data() + start;
+            const char* last = line.data() + line.size();
+            auto offsetOf = [&line](const char* at) {
+                return static_cast<std::size_t>(at - line.data());
+            };
+            if (first == last) {
+                return start;
+            }
+
+            if constexpr (std::is_same_v<T, bool>) {
+                long number = 0;
+                std::size_t error = parseLine(line.substr(start), number, valueStart);
+                valueStart = start;
+                if (error != std::string_view::npos) {
+                    return start + error;
+                }
+                if (number != 0 && number != 1) {
+                    return start;
+                }
+                value = number == 1;
+                return std::string_view::npos;
+            } else if constexpr (std::is_same_v<T, char> || std::is_same_v<T, signed char> ||
+                                 std::is_same_v<T, unsigned char>) {
+                value = static_cast<T>(*first);
+                return first + 1 == last ? std::string_view::npos : offsetOf(first + 1);
+            } else if constexpr (std::is_integral_v<T> ||
+                                 (std::is_floating_point_v<T> && floatingFromChars)) {
+                if (*first == '+' && last - first > 1 && first[1] != '-' && first[1] != '+') {
+                    ++first;
+                }
+                if constexpr (std::is_floating_point_v<T>) {
+                    const char* digits = first + (*first == '-' || *first == '+' ? 1 : 0);
+                    if (digits != last && *digits != '.' && (*digits < '0' || *digits > '9')) {
+                        return offsetOf(digits);
+                    }
+                }
+                T parsed{};
+                auto [stop, error] = std::from_chars(first, last, parsed);
+                if (error == std::errc::invalid_argument) {
+                    return offsetOf(first);
+                }
+                if (error == std::errc::result_out_of_range) {
+                    return start;
+                }
+                if (stop != last) {
+                    return offsetOf(stop);
+                }
+                value = parsed;
+                return std::string_view::npos;
+            } else if constexpr (std::is_same_v<T, std::string>) {
+                const char* end = first;
+                while (end != last && !isStreamSpace(*end)) {
+                    ++end;
+                }
+                if (end != last) {
+                    return offsetOf(end);
+                }
+                value.assign(first, end);
+                return std::string_view::npos;
+            } else {
+                std::istringstream stream{std::string(line)};
+                if (!(stream >> value)) {
+                    return start;
+                }
+                if (!stream.eof()) {
+                    return static_cast<std::size_t>(stream.tellg());
+                }
+                return std::string_view::npos;
+            }
+        }
+
+        /**
+         * @brief Applies a readValidatedInput-style validator: nullptr and empty callables
+         *        (e.g. a default std::function) accept everything.
+         */
+        template<typename Validator, typename T>
+        bool passesValidator(const Validator& validator, const T& value) {
+            if constexpr (std::is_null_pointer_v<Validator>) {
+                return true;
+            } else if constexpr (std::is_constructible_v<bool, const Validator&>) {
+                return !validator || static_cast<bool>(validator(value));
+            } else {
+                return static_cast<bool>(validator(value));
+            }
+        }
+
+        /**
+         * @brief Calls @p function, treating a void result as "continue".
+         */
+        template<typename Func, typename... Args>
+        bool invokeContinuing(Func& function, Args&&... args) {
+            if constexpr (std::is_void_v<std::invoke_result_t<Func&, Args...>>) {
+                function(std::forward<Args>(args)...);
+                return true;
+            } else {
+                return static_cast<bool>(function(std::forward<Args>(args)...));
+            }
+        }
+
+    } // namespace detail
+
+    /**
+     * @struct InputError
+     * @brief A line of bulk input that was rejected, as reported by forEachValidatedValue().
+     */
+    struct InputError {
+        enum class Kind {
+            Format,     ///< The line does not parse as the value type
+            Validation  ///< The value parsed but the validator rejected it
+        };
+
+        Kind kind;
+
+        /**
+         * @brief 1-based line number.
+         */
+        std::size_t line;
+
+        /**
+         * @brief 1-based column: the first offending character for Format errors, the start of
+         *        the value for Validation errors.
+         */
+        std::size_t column;
+
+        /**
+         * @brief The rejected line (without its '\n'), a view into the input.
+         */
+        std::string_view text;
+    };
+
+    /**
+     * @struct ValidatedValues
+     * @brief Accepted values and rejected lines from readValidatedValues().
+     */
+    template<typename T>
+    struct ValidatedValues {
+        std::vector<T> values;
+        std::vector<InputError> errors;
+    };
+
+    /**
+     * @brief Parses one value per line of @p input without prompting, for piped or mapped
+     *        files.
+     *
+     * Every line is parsed and validated exactly as readValidatedInput() would accept or
+     * reject it when typed at the prompt: both use detail::parseLine, which works with
+     * std::from_chars on the input bytes instead of a stream per line. Lines end at
+     * '\n'; a final line without one is still read. Rejected lines are reported and skipped.
+     *
+     * @tparam T Data type to parse.
+     * @param input The whole input, e.g. `std::string_view(static_cast<const char*>(
+     *              file.data()), file.size())` for a MappedFile.
+     * @param onValue Called with each accepted `T&&`; may return bool, false stops reading.
+     * @param onError Called with each `const InputError&`; may return bool, false stops.
+     * @param validator Callable `bool(const T&)` called once per parsed value, or nullptr.
+     * @return Number of values passed to @p onValue.
+     *
+     * @example
+     * ```cpp
+     * Sefn::MappedFile file("ids.txt");
+     * std::string_view text(static_cast<const char*>(file.data()), file.size());
+     * Sefn::forEachValidatedValue<std::uint64_t>(
+     *     text, [&](std::uint64_t id) { ids.push_back(id); },
+     *     [](const Sefn::InputError& e) { std::cerr << e.line << ':' << e.column << '\n'; },
+     *     [](std::uint64_t id) { return id != 0; });
+     * ```
+     */
+    template<typename T, typename OnValue, typename OnError, typename Validator = std::nullptr_t>
+    std::size_t forEachValidatedValue(std::string_view input, OnValue onValue, OnError onError,
+                                      const Validator& validator = nullptr) {
+        std::size_t accepted = 0;
+        std::size_t lineNumber = 0;
+        T value{};
+        while (!input.empty()) {
+            std::size_t end = input.find('\n');
+            std::string_view line = input.substr(0, end);
+            input.remove_prefix(end == std::string_view::npos ? input.size() : end + 1);
+            ++lineNumber;
+
+            std::size_t valueStart = 0;
+            std::size_t error = detail::parseLine(line, value, valueStart);
+            if (error != std::string_view::npos) {
+                InputError report{InputError::Kind::Format, lineNumber, error + 1, line};
+                if (!detail::invokeContinuing(onError, static_cast<const InputError&>(report))) {
+                    break;
+                }
+            } else if (!detail::passesValidator(validator, static_cast<const T&>(value))) {
+                InputError report{InputError::Kind::Validation, lineNumber, valueStart + 1, line};
+                if (!detail::invokeContinuing(onError, static_cast<const InputError&>(report))) {
+                    break;
+                }
+            } else {
+                ++accepted;
+                if (!detail::invokeContinuing(onValue, std::move(value))) {
+                    break;
+                }
+            }
+        }
+        return accepted;
+    }
+
+    /**
+     * @brief Collects forEachValidatedValue() results: the accepted values in input order and
+     *        every rejected line.
+     *
+     * @example
+     * ```cpp
+     * auto ports = Sefn::readValidatedValues<int>(text, [](int p) { return p > 0 && p < 65536; });
+     * for (const Sefn::InputError& e : ports.errors) { ... }
+     * ```
+     */
+    template<typename T, typename Validator = std::nullptr_t>
+    ValidatedValues<T> readValidatedValues(std::string_view input,
+                                           const Validator& validator = nullptr) {
+        ValidatedValues<T> result;
+        forEachValidatedValue<T>(
+            input, [&result](T&& value) { result.values.push_back(std::move(value)); },
+            [&result](const InputError& error) { result.errors.push_back(error); }, validator);
+        return result;
+    }
     
     /**
      * @brief Reads and validates user input from standard input.
      *
      * Prompts the user, reads a line, and parses it into type T.
      * Optionally validates the parsed value with a custom function.
+     * Lines are judged as by `operator>>` on the whole line, with the two exceptions listed
+     * on detail::parseLine: `-1` is not an unsigned value, and a char is a one-character line.
      *
      * @tparam T Data type to read and return.
      * @param prompt Message to display to the user.
@@ -57,8 +328,8 @@ namespace Sefn {
                 continue;
             }
             
-            std::stringstream ss(line);
-            if ((ss >> value) && ss.eof()) {
+            std::size_t valueStart = 0;
+            if (detail::parseLine(line, value, valueStart) == std::string_view::npos) {
                 if (!validator || validator(value)) {
                     break;
                 } else {
@@ -70,6 +341,117 @@ namespace Sefn {
         }
         return value;
     }
-        
+
+    /**
+     * @class InputSession
+     * @brief An input/output stream pair plus the line buffer readValidatedInput reuses.
+     *
+     * @details Keep one session per console or connection: the buffer keeps its capacity
+     * between reads, so once it has seen the longest line, reading allocates nothing. Sessions
+     * share no state, so different sessions can be used from different threads.
+     *
+     * @example
+     * ```cpp
+     * Sefn::InputSession session(connection.in(), connection.out());
+     * while (auto port = Sefn::readValidatedInput<int>(session, "Port: ", 0,
+     *                                                   [](int p) { return p > 0; })) {
+     *     listen(*port);
+     * }
+     * ```
+     */
+    class InputSession {
+    public:
+        InputSession(std::istream& input, std::ostream& output) : in(&input), out(&output) {}
+
+        std::istream& input() const {
+            return *in;
+        }
+
+        std::ostream& output() const {
+            return *out;
+        }
+
+        /**
+         * @brief The buffer the last line was read into.
+         */
+        std::string& lineBuffer() {
+            return line;
+        }
+
+    private:
+        std::istream* in;
+        std::ostream* out;
+        std::string line;
+    };
+
+    /**
+     * @brief readValidatedInput() on a session's streams, returning std::nullopt at end of
+     *        input instead of retrying.
+     *
+     * Lines are accepted or rejected, and prompts, error messages and indentation written,
+     * exactly as by the console overload; both parse with detail::parseLine. Nothing is
+     * allocated per attempt: messages are written straight from their views, the validator
+     * is any callable (no std::function) and the line is parsed in the session's buffer.
+     *
+     * @tparam T Data type to read and return.
+     * @param session Streams and line buffer to use.
+     * @param prompt Message to display before each attempt.
+     * @param indentTabs Number of tabs to indent prompts and messages.
+     * @param validator Callable `bool(const T&)` returning true for valid values, or nullptr.
+     * @param errorMessage Message shown when validation fails.
+     * @param formatErrorMessage Message shown when parsing fails.
+     * @return The validated value, or std::nullopt if the input ended (or failed) first.
+     */
+    template<typename T, typename Validator = std::nullptr_t>
+    std::optional<T> readValidatedInput(
+        InputSession& session, std::string_view prompt, int indentTabs = 0,
+        const Validator& validator = nullptr,
+        std::string_view errorMessage = "Invalid value. Please try again.\n",
+        std::string_view formatErrorMessage = "Invalid format. Please try again.\n") {
+        std::ostream& out = session.output();
+        std::string& line = session.lineBuffer();
+        auto indent = [&out, indentTabs](int extra) {
+            for (int i = 0; i < indentTabs + extra; ++i) {
+                out.put('\t');
+            }
+        };
+
+        T value{};
+        while (true) {
+            indent(0);
+            out << prompt;
+
+            if (!std::getline(session.input(), line)) {
+                return std::nullopt;
+            }
+
+            std::size_t valueStart = 0;
+            if (detail::parseLine(line, value, valueStart) != std::string_view::npos) {
+                indent(1);
+                out << formatErrorMessage;
+            } else if (!detail::passesValidator(validator, static_cast<const T&>(value))) {
+                indent(1);
+                out << errorMessage;
+            } else {
+                return value;
+            }
+        }
+    }
+
+    /**
+     * @brief readValidatedInput() on arbitrary streams, with a line buffer for this call only.
+     * @details Prefer the InputSession overload in loops: it keeps the buffer between calls.
+     */
+    template<typename T, typename Validator = std::nullptr_t>
+    std::optional<T> readValidatedInput(
+        std::istream& input, std::ostream& output, std::string_view prompt, int indentTabs = 0,
+        const Validator& validator = nullptr,
+        std::string_view errorMessage = "Invalid value. Please try again.\n",
+        std::string_view formatErrorMessage = "Invalid format. Please try again.\n") {
+        InputSession session(input, output);
+        return readValidatedInput<T>(session, prompt, indentTabs, validator, errorMessage,
+                                     formatErrorMessage);
+    }
+
 } // namespace Sefn
     
\ No newline at end of file
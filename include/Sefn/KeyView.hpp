@@ -0,0 +1,155 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <iterator>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
+/**
+ * @file Sefn/KeyView.hpp
+ * @brief Non-owning key parameter accepted by the Trie family.
+ */
+
+namespace Sefn {
+
+    namespace detail {
+
+        /**
+         * @brief True for the character types std::char_traits is defined for.
+         */
+        template<class CharT>
+        constexpr bool isCharacter = std::is_same_v<CharT, char> ||
+                                     std::is_same_v<CharT, wchar_t> ||
+                                     std::is_same_v<CharT, char16_t> ||
+                                     std::is_same_v<CharT, char32_t>;
+
+        template<class Range, class CharT, class = void>
+        struct IsKeyRange : std::false_type {};
+
+        /**
+         * @brief Matches ranges exposing `std::data()` as `const CharT*` and `std::size()`.
+         * @details Arrays and anything convertible to `const CharT*` are excluded so that string
+         *          literals keep their C-string meaning (no trailing '\0' in the key).
+         */
+        template<class Range, class CharT>
+        struct IsKeyRange<Range, CharT, std::void_t<decltype(std::data(std::declval<const Range&>())),
+                                                    decltype(std::size(std::declval<const Range&>()))>>
+            : std::bool_constant<
+                  std::is_same_v<std::remove_cv_t<std::remove_pointer_t<
+                                     decltype(std::data(std::declval<const Range&>()))>>,
+                                 CharT> &&
+                  !std::is_array_v<Range> && !std::is_convertible_v<const Range&, const CharT*>> {};
+
+    } // namespace detail
+
+    /**
+     * @class BasicKeyView
+     * @brief Read-only view of a key: a pointer and a length over elements of @p CharT.
+     *
+     * @details Built implicitly from any contiguous range of @p CharT (`std::basic_string`,
+     * `std::basic_string_view`, `std::vector<CharT>`, `std::array<CharT, N>`) and, for character
+     * types, from C strings. For character types it also converts to `std::basic_string_view`.
+     * The viewed elements must stay alive for the duration of the call that receives the view.
+     *
+     * @tparam CharT Key element type: a character type, or an integer for token, nibble or
+     *         bit keys.
+     *
+     * @example
+     * ```cpp
+     * std::vector<char> packet = receive();
+     * trie.wordExists(packet);                               // whole buffer as the key
+     * trie.wordExists(std::string_view(packet.data(), 4));  // slice, no allocation
+     * ```
+     */
+    template<class CharT>
+    class BasicKeyView {
+    public:
+        using value_type = CharT;
+        using size_type = std::size_t;
+        using const_iterator = const CharT*;
+        using iterator = const_iterator;
+
+        static constexpr size_type npos = static_cast<size_type>(-1);
+
+        constexpr BasicKeyView() noexcept = default;
+
+        constexpr BasicKeyView(const CharT* data, size_type size) noexcept
+            : first(data), count(size) {}
+
+        /**
+         * @brief Views a null-terminated string (character types only).
+         */
+        template<class C = CharT, class = std::enable_if_t<detail::isCharacter<C>>>
+        constexpr BasicKeyView(const CharT* string) noexcept
+            : first(string), count(std::char_traits<CharT>::length(string)) {}
+
+        template<class Range, class = std::enable_if_t<!std::is_same_v<Range, BasicKeyView> &&
+                                                     detail::IsKeyRange<Range, CharT>::value>>
+        constexpr BasicKeyView(const Range& range) noexcept
+            : first(std::data(range)), count(static_cast<size_type>(std::size(range))) {}
+
+        template<class C = CharT, class = std::enable_if_t<detail::isCharacter<C>>>
+        constexpr operator std::basic_string_view<CharT>() const noexcept {
+            return {first, count};
+        }
+
+        constexpr const CharT* data() const noexcept { return first; }
+        constexpr size_type size() const noexcept { return count; }
+        constexpr bool empty() const noexcept { return count == 0; }
+        constexpr const CharT& operator[](size_type index) const { return first[index]; }
+        constexpr const_iterator begin() const noexcept { return first; }
+        constexpr const_iterator end() const noexcept { return first + count; }
+
+        /**
+         * @brief View of at most @p length elements starting at @p position (clamped to size()).
+         */
+        constexpr BasicKeyView substr(size_type position, size_type length = npos) const noexcept {
+            position = std::min(position, count);
+            return {first + position, std::min(length, count - position)};
+        }
+
+        friend bool operator==(BasicKeyView a, BasicKeyView b) {
+            return std::equal(a.begin(), a.end(), b.begin(), b.end());
+        }
+
+        friend bool operator!=(BasicKeyView a, BasicKeyView b) {
+            return !(a == b);
+        }
+
+        friend bool operator<(BasicKeyView a, BasicKeyView b) {
+            return std::lexicographical_compare(a.begin(), a.end(), b.begin(), b.end());
+        }
+
+    private:
+        const CharT* first = nullptr;
+        size_type count = 0;
+    };
+
+    /**
+     * @brief Key parameter type of the `char`-keyed tries.
+     */
+    using KeyView = BasicKeyView<char>;
+
+    namespace detail {
+
+        /**
+         * @brief Owning key buffer: std::basic_string for characters, std::vector otherwise.
+         */
+        template<class CharT>
+        using KeyString = std::conditional_t<isCharacter<CharT>, std::basic_string<CharT>,
+                                             std::vector<CharT>>;
+
+        /**
+         * @brief Key type handed out by iterators: std::basic_string_view for characters,
+         *        BasicKeyView otherwise.
+         */
+        template<class CharT>
+        using KeyStringView = std::conditional_t<isCharacter<CharT>, std::basic_string_view<CharT>,
+                                                 BasicKeyView<CharT>>;
+
+    } // namespace detail
+
+} // namespace Sefn
@@ -0,0 +1,171 @@
+#pragma once
+
+#include <cstddef>
+#include <string>
+#include <utility>
+
+#if defined(_WIN32)
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+/**
+ * @file Sefn/MappedFile.hpp
+ * @brief Read-only memory-mapped file.
+ */
+
+namespace Sefn {
+
+    /**
+     * @class MappedFile
+     * @brief Maps a whole file read-only into memory for the lifetime of the object.
+     *
+     * @details Pages are loaded lazily by the operating system and shared between processes
+     * mapping the same file, so opening a large file costs next to nothing.
+     *
+     * @example
+     * ```cpp
+     * Sefn::MappedFile file("dictionary.bin");
+     * if (!file.isOpen()) { ... }
+     * process(file.data(), file.size());
+     * ```
+     */
+    class MappedFile {
+    public:
+        /**
+         * @brief Creates a closed MappedFile.
+         */
+        MappedFile() = default;
+
+        /**
+         * @brief Maps @p path. Check isOpen() for success.
+         */
+        explicit MappedFile(const std::string& path) {
+            open(path);
+        }
+
+        MappedFile(const MappedFile&) = delete;
+        MappedFile& operator=(const MappedFile&) = delete;
+
+        MappedFile(MappedFile&& other) noexcept {
+            swap(other);
+        }
+
+        MappedFile& operator=(MappedFile&& other) noexcept {
+            if (this != &other) {
+                close();
+                swap(other);
+            }
+            return *this;
+        }
+
+        /**
+         * @brief Destructor. Unmaps the file.
+         */
+        ~MappedFile() {
+            close();
+        }
+
+        /**
+         * @brief Maps @p path, replacing any file mapped before.
+         * @return True on success. Empty files cannot be mapped.
+         */
+        bool open(const std::string& path) {
+            close();
+#if defined(_WIN32)
+            HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr,
+                                      OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+            if (file == INVALID_HANDLE_VALUE) {
+                return false;
+            }
+            LARGE_INTEGER length;
+            if (!GetFileSizeEx(file, &length) || length.QuadPart == 0) {
+                CloseHandle(file);
+                return false;
+            }
+            HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+            CloseHandle(file);
+            if (!mapping) {
+                return false;
+            }
+            void* view = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+            CloseHandle(mapping);
+            if (!view) {
+                return false;
+            }
+            address = view;
+            byteCount = static_cast<std::size_t>(length.QuadPart);
+#else
+            int descriptor = ::open(path.c_str(), O_RDONLY);
+            if (descriptor < 0) {
+                return false;
+            }
+            struct stat info;
+            if (::fstat(descriptor, &info) != 0 || info.st_size <= 0) {
+                ::close(descriptor);
+                return false;
+            }
+            void* view = ::mmap(nullptr, static_cast<std::size_t>(info.st_size), PROT_READ,
+                                MAP_PRIVATE, descriptor, 0);
+            ::close(descriptor);
+            if (view == MAP_FAILED) {
+                return false;
+            }
+            address = view;
+            byteCount = static_cast<std::size_t>(info.st_size);
+#endif
+            return true;
+        }
+
+        /**
+         * @brief Unmaps the file. Pointers obtained from data() become invalid.
+         */
+        void close() {
+            if (!address) {
+                return;
+            }
+#if defined(_WIN32)
+            UnmapViewOfFile(address);
+#else
+            ::munmap(address, byteCount);
+#endif
+            address = nullptr;
+            byteCount = 0;
+        }
+
+        bool isOpen() const {
+            return address != nullptr;
+        }
+
+        /**
+         * @brief Start of the mapped bytes (page aligned), or nullptr if closed.
+         */
+        const void* data() const {
+            return address;
+        }
+
+        /**
+         * @brief Number of mapped bytes.
+         */
+        std::size_t size() const {
+            return byteCount;
+        }
+
+    private:
+        void* address = nullptr;
+        std::size_t byteCount = 0;
+
+        void swap(MappedFile& other) noexcept {
+            std::swap(address, other.address);
+            std::swap(byteCount, other.byteCount);
+        }
+    };
+
+} // namespace Sefn
@@ -0,0 +1,360 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+/**
+ * @file Sefn/NodeStorage.hpp
+ * @brief Node storage policies used by the Sefn containers.
+ *
+ * A storage policy hands out raw memory for container nodes. Two policies are provided:
+ * - HeapStorage: every allocation goes straight to the global heap (the classic behavior).
+ * - PoolStorage: allocations are carved out of large slabs, freed blocks are recycled,
+ *   and everything can be returned at once in O(slabs).
+ */
+
+namespace Sefn {
+
+    /**
+     * @class HeapStorage
+     * @brief Storage policy that forwards every request to the global operator new/delete.
+     */
+    class HeapStorage {
+    public:
+        /**
+         * @brief HeapStorage cannot drop all of its blocks at once; each node is freed individually.
+         */
+        static constexpr bool releasesInBulk = false;
+
+        /**
+         * @brief The global heap may be used from several threads at once.
+         */
+        static constexpr bool threadSafe = true;
+
+        /**
+         * @brief Allocates @p bytes with the requested alignment.
+         */
+        void* allocate(std::size_t bytes, std::size_t alignment) {
+            if (alignment > alignof(std::max_align_t)) {
+                return ::operator new(bytes, std::align_val_t(alignment));
+            }
+            return ::operator new(bytes);
+        }
+
+        /**
+         * @brief Returns a block previously obtained from allocate().
+         */
+        void deallocate(void* block, std::size_t bytes, std::size_t alignment) noexcept {
+            (void)bytes;
+            if (alignment > alignof(std::max_align_t)) {
+                ::operator delete(block, std::align_val_t(alignment));
+            } else {
+                ::operator delete(block);
+            }
+        }
+
+        /**
+         * @brief No-op; blocks are owned by the global heap.
+         */
+        void release() noexcept {}
+    };
+
+    /**
+     * @class PoolStorage
+     * @brief Slab-based storage policy with per-size free lists.
+     *
+     * @details
+     * Small requests (up to maxPooledSize bytes) are rounded up to a multiple of
+     * `alignof(std::max_align_t)` and served by bumping a pointer inside the current slab.
+     * Deallocated blocks go on a free list for their size class and are handed out again
+     * before new slab space is used, so erase/insert churn does not grow the pool.
+     * Larger requests get their own block, tracked so release() can still free them.
+     *
+     * @note Not thread-safe. Tries sharing a pool must not be modified concurrently.
+     */
+    class PoolStorage {
+    public:
+        /**
+         * @brief Slabs free all of their blocks in one step in release().
+         */
+        static constexpr bool releasesInBulk = true;
+
+        /**
+         * @brief A pool must only be used by one thread at a time (see adopt() for
+         *        per-thread arenas).
+         */
+        static constexpr bool threadSafe = false;
+
+        /**
+         * @brief Largest request served from slabs; anything bigger gets a dedicated block.
+         */
+        static constexpr std::size_t maxPooledSize = 4096;
+
+        /**
+         * @brief Creates an empty pool.
+         * @param slabSize Size in bytes of each slab. Clamped to at least maxPooledSize.
+         */
+        explicit PoolStorage(std::size_t slabSize = 64 * 1024)
+            : slabSize(slabSize < maxPooledSize ? maxPooledSize : slabSize) {}
+
+        PoolStorage(const PoolStorage&) = delete;
+        PoolStorage& operator=(const PoolStorage&) = delete;
+
+        /**
+         * @brief Destructor. Frees every slab and large block.
+         */
+        ~PoolStorage() {
+            release();
+        }
+
+        /**
+         * @brief Allocates @p bytes with the requested alignment.
+         */
+        void* allocate(std::size_t bytes, std::size_t alignment) {
+            if (bytes > maxPooledSize || alignment > granularity) {
+                return allocateLarge(bytes, alignment);
+            }
+            std::size_t sizeClass = classOf(bytes);
+            if (FreeBlock* block = freeLists[sizeClass]) {
+                freeLists[sizeClass] = block->next;
+                return block;
+            }
+            std::size_t rounded = (sizeClass + 1) * granularity;
+            if (static_cast<std::size_t>(limit - cursor) < rounded) {
+                addSlab();
+            }
+            void* block = cursor;
+            cursor += rounded;
+            return block;
+        }
+
+        /**
+         * @brief Returns a block to its free list (or frees it, for large blocks).
+         */
+        void deallocate(void* block, std::size_t bytes, std::size_t alignment) noexcept {
+            if (bytes > maxPooledSize || alignment > granularity) {
+                deallocateLarge(block, alignment);
+                return;
+            }
+            std::size_t sizeClass = classOf(bytes);
+            FreeBlock* freed = static_cast<FreeBlock*>(block);
+            freed->next = freeLists[sizeClass];
+            freeLists[sizeClass] = freed;
+        }
+
+        /**
+         * @brief Frees all memory handed out by this pool in O(slabs).
+         * @warning Every pointer previously returned by allocate() becomes invalid.
+         *          No destructors are run for objects living in the pool.
+         */
+        void release() noexcept {
+            while (slabs) {
+                Slab* next = slabs->next;
+                ::operator delete(slabs);
+                slabs = next;
+            }
+            while (largeBlocks) {
+                LargeBlock* next = largeBlocks->next;
+                std::size_t alignment = largeBlocks->alignment;
+                ::operator delete(largeBlocks, std::align_val_t(alignment));
+                largeBlocks = next;
+            }
+            freeLists.fill(nullptr);
+            cursor = limit = nullptr;
+            slabTotal = 0;
+            adopted.clear();
+        }
+
+        /**
+         * @brief Takes ownership of @p arena, typically a pool filled by another thread.
+         * @details Blocks handed out by @p arena may afterwards be returned to this pool, and
+         *          are freed by this pool's release() and destructor. The arena object itself
+         *          stays alive until then, so allocators bound to it remain valid. Large blocks
+         *          stay in the arena's list (each block knows its owning pool), so freeing them
+         *          through either pool keeps both lists intact.
+         */
+        void adopt(std::unique_ptr<PoolStorage> arena) {
+            if (arena) {
+                adopted.push_back(std::move(arena));
+            }
+        }
+
+        /**
+         * @brief Number of slabs currently held by the pool, adopted arenas included.
+         */
+        std::size_t slabCount() const {
+            std::size_t total = slabTotal;
+            for (const auto& arena : adopted) {
+                total += arena->slabCount();
+            }
+            return total;
+        }
+
+    private:
+        static constexpr std::size_t granularity = alignof(std::max_align_t);
+
+        struct FreeBlock {
+            FreeBlock* next;
+        };
+
+        struct alignas(std::max_align_t) Slab {
+            Slab* next;
+        };
+
+        /**
+         * @brief Header of a dedicated block, linked into the list of the pool that allocated
+         *        it. Adopted arenas keep their own lists, so a block freed through another pool
+         *        is unlinked from its owner's list.
+         */
+        struct LargeBlock {
+            LargeBlock* prev;
+            LargeBlock* next;
+            PoolStorage* owner;
+            std::size_t alignment;
+        };
+
+        std::size_t slabSize;
+        std::array<FreeBlock*, maxPooledSize / granularity> freeLists{};
+        Slab* slabs = nullptr;
+        LargeBlock* largeBlocks = nullptr;
+        char* cursor = nullptr;
+        char* limit = nullptr;
+        std::size_t slabTotal = 0;
+        std::vector<std::unique_ptr<PoolStorage>> adopted;
+
+        static std::size_t classOf(std::size_t bytes) {
+            return bytes == 0 ? 0 : (bytes - 1) / granularity;
+        }
+
+        static std::size_t headerSize(std::size_t alignment) {
+            return (sizeof(LargeBlock) + alignment - 1) / alignment * alignment;
+        }
+
+        void addSlab() {
+            void* raw = ::operator new(sizeof(Slab) + slabSize);
+            Slab* slab = static_cast<Slab*>(raw);
+            slab->next = slabs;
+            slabs = slab;
+            cursor = reinterpret_cast<char*>(slab + 1);
+            limit = cursor + slabSize;
+            ++slabTotal;
+        }
+
+        void* allocateLarge(std::size_t bytes, std::size_t alignment) {
+            alignment = alignment < granularity ? granularity : alignment;
+            std::size_t header = headerSize(alignment);
+            void* raw = ::operator new(header + bytes, std::align_val_t(alignment));
+            LargeBlock* block = static_cast<LargeBlock*>(raw);
+            block->prev = nullptr;
+            block->next = largeBlocks;
+            block->owner = this;
+            block->alignment = alignment;
+            if (largeBlocks) {
+                largeBlocks->prev = block;
+            }
+            largeBlocks = block;
+            return static_cast<char*>(raw) + header;
+        }
+
+        void deallocateLarge(void* block, std::size_t alignment) noexcept {
+            alignment = alignment < granularity ? granularity : alignment;
+            LargeBlock* large = reinterpret_cast<LargeBlock*>(
+                static_cast<char*>(block) - headerSize(alignment));
+            if (large->prev) {
+                large->prev->next = large->next;
+            } else {
+                large->owner->largeBlocks = large->next;
+            }
+            if (large->next) {
+                large->next->prev = large->prev;
+            }
+            ::operator delete(large, std::align_val_t(alignment));
+        }
+    };
+
+    namespace detail {
+
+        template<class Storage, class = void>
+        struct IsThreadSafeStorage : std::false_type {};
+
+        /**
+         * @brief True if @p Storage declares `threadSafe = true`; storages without the
+         *        member are assumed not to be.
+         */
+        template<class Storage>
+        struct IsThreadSafeStorage<Storage, std::enable_if_t<Storage::threadSafe>>
+            : std::true_type {};
+
+        template<class Storage, class = void>
+        struct CanAdoptStorage : std::false_type {};
+
+        /**
+         * @brief True if @p Storage has `adopt(std::unique_ptr<Storage>)`.
+         */
+        template<class Storage>
+        struct CanAdoptStorage<Storage, std::void_t<decltype(std::declval<Storage&>().adopt(
+                                            std::declval<std::unique_ptr<Storage>>()))>>
+            : std::true_type {};
+
+    } // namespace detail
+
+    /**
+     * @class StorageAllocator
+     * @brief Standard-library compatible allocator that draws from a storage policy.
+     *
+     * @details Lets standard containers living inside nodes (e.g. a child map) share the
+     * node storage, so a pooled container can drop all of its memory in one step.
+     *
+     * @tparam U Value type allocated by this allocator.
+     * @tparam Storage Storage policy (HeapStorage, PoolStorage, ...).
+     */
+    template<class U, class Storage>
+    class StorageAllocator {
+    public:
+        using value_type = U;
+
+        template<class V>
+        struct rebind {
+            using other = StorageAllocator<V, Storage>;
+        };
+
+        /**
+         * @brief Creates an allocator bound to @p storage. The storage must outlive it.
+         */
+        explicit StorageAllocator(Storage* storage) noexcept : storage(storage) {}
+
+        template<class V>
+        StorageAllocator(const StorageAllocator<V, Storage>& other) noexcept
+            : storage(other.storage) {}
+
+        U* allocate(std::size_t count) {
+            return static_cast<U*>(storage->allocate(count * sizeof(U), alignof(U)));
+        }
+
+        void deallocate(U* block, std::size_t count) noexcept {
+            storage->deallocate(block, count * sizeof(U), alignof(U));
+        }
+
+        template<class V>
+        bool operator==(const StorageAllocator<V, Storage>& other) const noexcept {
+            return storage == other.storage;
+        }
+
+        template<class V>
+        bool operator!=(const StorageAllocator<V, Storage>& other) const noexcept {
+            return storage != other.storage;
+        }
+
+    private:
+        template<class V, class S>
+        friend class StorageAllocator;
+
+        Storage* storage;
+    };
+
+} // namespace Sefn
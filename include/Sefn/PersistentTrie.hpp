@@ -0,0 +1,421 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include "KeyView.hpp"
+
+/**
+ * @file Sefn/PersistentTrie.hpp
+ * @brief Immutable prefix tree whose updates return new versions sharing untouched nodes.
+ */
+
+namespace Sefn {
+
+    /**
+     * @class PersistentTrie
+     * @brief A persistent (fully immutable) prefix tree with O(1) snapshots.
+     *
+     * @details
+     * insert() and erase() never modify a version: they copy the nodes on the path of the
+     * word (path copying) and return a new version that shares every other node with the
+     * old one. Nodes are reference counted, so copying a PersistentTrie is O(1) and a node is
+     * freed when the last version using it goes away.
+     *
+     * An update costs O(m * fanout) time and allocates at most m + 1 nodes, where m is the
+     * word length. Queries have the same complexity as on Trie.
+     *
+     * Thread safety: versions are immutable, so any number of threads may read, copy and
+     * destroy versions concurrently. A single PersistentTrie object behaves like a
+     * std::shared_ptr: assigning to it while another thread reads that same object is a race.
+     * A writer therefore typically swaps the published handle under a short lock, and readers
+     * copy it out under the same lock and then query their copy without one.
+     *
+     * @tparam T Type of object to associate with each word.
+     *
+     * @note Does not take ownership of T* pointers; user is responsible for memory management.
+     *
+     * @example
+     * ```cpp
+     * Sefn::PersistentTrie<Doc> live;
+     * live = live.insert(&doc, "report");
+     * Sefn::PersistentTrie<Doc> snapshot = live;  // O(1), unaffected by later updates
+     * live = live.erase("report");
+     * exportAll(snapshot);                        // still sees "report"
+     * ```
+     */
+    template<class T>
+    class PersistentTrie {
+    private:
+        /**
+         * @brief An immutable node; shared by every version that reaches it.
+         */
+        struct Node {
+            /**
+             * @brief Number of versions and parent nodes pointing at this node.
+             */
+            std::atomic<std::size_t> references{1};
+
+            /**
+             * @brief Object stored for the word ending at this node, or nullptr.
+             */
+            T* object = nullptr;
+
+            /**
+             * @brief Outgoing edges sorted by character.
+             */
+            std::vector<std::pair<char, Node*>> children;
+        };
+
+        using Edge = std::pair<char, Node*>;
+
+        /**
+         * @brief Root of this version; nullptr for an empty Trie.
+         */
+        Node* root = nullptr;
+
+        /**
+         * @brief Number of words in this version.
+         */
+        std::size_t wordCount = 0;
+
+        PersistentTrie(Node* root, std::size_t wordCount) : root(root), wordCount(wordCount) {}
+
+        static void retain(Node* node) noexcept {
+            if (node) {
+                node->references.fetch_add(1, std::memory_order_relaxed);
+            }
+        }
+
+        /**
+         * @brief Drops one reference; frees the nodes that no version reaches any more.
+         * @details Iterative so that releasing a deep version cannot overflow the call stack.
+         */
+        static void release(Node* node) noexcept {
+            std::vector<Node*> pending;
+            while (true) {
+                if (node && node->references.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+                    for (const Edge& edge : node->children) {
+                        pending.push_back(edge.second);
+                    }
+                    delete node;
+                }
+                if (pending.empty()) {
+                    return;
+                }
+                node = pending.back();
+                pending.pop_back();
+            }
+        }
+
+        /**
+         * @brief New node with the object and edges of @p source; shares its children.
+         */
+        static Node* copyNode(const Node* source) {
+            auto copy = std::make_unique<Node>();
+            copy->object = source->object;
+            copy->children = source->children;
+            for (const Edge& edge : copy->children) {
+                retain(edge.second);
+            }
+            return copy.release();
+        }
+
+        static auto edgeFor(const std::vector<Edge>& children, char ch) {
+            return std::lower_bound(children.begin(), children.end(), ch,
+                                    [](const Edge& edge, char key) { return edge.first < key; });
+        }
+
+        static auto edgeFor(std::vector<Edge>& children, char ch) {
+            return std::lower_bound(children.begin(), children.end(), ch,
+                                    [](const Edge& edge, char key) { return edge.first < key; });
+        }
+
+        static const Node* childOf(const Node* node, char ch) {
+            auto it = edgeFor(node->children, ch);
+            return it != node->children.end() && it->first == ch ? it->second : nullptr;
+        }
+
+        /**
+         * @brief Points the @p ch edge of the fresh node @p parent at @p child (nullptr removes
+         *        it). @p parent takes over the reference to @p child only on success.
+         */
+        static void replaceChild(Node* parent, char ch, Node* child) {
+            auto it = edgeFor(parent->children, ch);
+            if (it != parent->children.end() && it->first == ch) {
+                release(it->second);
+                if (child) {
+                    it->second = child;
+                } else {
+                    parent->children.erase(it);
+                }
+            } else if (child) {
+                parent->children.insert(it, {ch, child});
+            }
+        }
+
+        /**
+         * @brief Nodes along @p word in this version; entries past the end of the stored
+         *        path are nullptr.
+         */
+        std::vector<const Node*> pathOf(KeyView word) const {
+            std::vector<const Node*> trail(word.size() + 1, nullptr);
+            const Node* current = root;
+            for (std::size_t i = 0; current; ++i) {
+                trail[i] = current;
+                if (i == word.size()) {
+                    break;
+                }
+                current = childOf(current, word[i]);
+            }
+            return trail;
+        }
+
+        /**
+         * @brief Copies the path above depth @p depth of @p trail, hanging @p built (the
+         *        replacement for the node at that depth, or nullptr to drop it) below it.
+         * @details A copied ancestor left without word and children is dropped as well.
+         *          Takes over the reference to @p built, also when an allocation throws.
+         * @return Root of the new version, or nullptr if it is empty.
+         */
+        static Node* copyPath(const std::vector<const Node*>& trail, KeyView word,
+                              std::size_t depth, Node* built) {
+            for (std::size_t i = depth; i-- > 0;) {
+                const Node* parent = trail[i];
+                if (!built && parent && !parent->object && parent->children.size() == 1) {
+                    continue;  // parent only led to the removed node
+                }
+                Node* copy = nullptr;
+                try {
+                    copy = parent ? copyNode(parent) : new Node();
+                    replaceChild(copy, word[i], built);
+                } catch (...) {
+                    release(copy);
+                    release(built);
+                    throw;
+                }
+                built = copy;
+            }
+            return built;
+        }
+
+        /**
+         * @brief Node for @p prefix, or nullptr if no word starts with it.
+         */
+        const Node* find(KeyView prefix) const {
+            const Node* current = root;
+            for (std::size_t i = 0; current && i < prefix.size(); ++i) {
+                current = childOf(current, prefix[i]);
+            }
+            return current;
+        }
+
+        /**
+         * @brief Applies a function to the objects below @p node in lexicographic order until
+         *        it returns false.
+         */
+        template<typename Func>
+        static void visitSubtree(const Node* node, Func& function) {
+            std::vector<const Node*> pending{node};
+            while (!pending.empty()) {
+                const Node* current = pending.back();
+                pending.pop_back();
+                if (current->object && !function(current->object)) {
+                    return;
+                }
+                for (auto it = current->children.rbegin(); it != current->children.rend(); ++it) {
+                    pending.push_back(it->second);
+                }
+            }
+        }
+
+        /**
+         * @brief Adapts a user callback to the bool-returning form used by visitSubtree().
+         * @details Callbacks returning void never stop the walk.
+         */
+        template<typename Func>
+        static bool invokeVisitor(Func& function, T* object) {
+            if constexpr (std::is_void_v<std::invoke_result_t<Func&, T*>>) {
+                function(object);
+                return true;
+            } else {
+                return static_cast<bool>(function(object));
+            }
+        }
+
+    public:
+        /**
+         * @brief Creates an empty Trie.
+         */
+        PersistentTrie() = default;
+
+        /**
+         * @brief Takes a snapshot of @p other in O(1); both share all nodes.
+         */
+        PersistentTrie(const PersistentTrie& other) noexcept
+            : root(other.root), wordCount(other.wordCount) {
+            retain(root);
+        }
+
+        PersistentTrie(PersistentTrie&& other) noexcept
+            : root(std::exchange(other.root, nullptr)),
+              wordCount(std::exchange(other.wordCount, 0)) {}
+
+        PersistentTrie& operator=(const PersistentTrie& other) noexcept {
+            retain(other.root);
+            release(root);
+            root = other.root;
+            wordCount = other.wordCount;
+            return *this;
+        }
+
+        PersistentTrie& operator=(PersistentTrie&& other) noexcept {
+            if (this != &other) {
+                release(root);
+                root = std::exchange(other.root, nullptr);
+                wordCount = std::exchange(other.wordCount, 0);
+            }
+            return *this;
+        }
+
+        /**
+         * @brief Drops this version; nodes still used by other versions stay alive.
+         */
+        ~PersistentTrie() {
+            release(root);
+        }
+
+        /**
+         * @brief Returns a version in which @p word maps to @p object.
+         * @details Copies the nodes on the path of @p word; this version is unchanged.
+         *          Inserting nullptr is the same as erase(word).
+         */
+        [[nodiscard]] PersistentTrie insert(T* object, KeyView word) const {
+            if (!object) {
+                return erase(word);
+            }
+            std::vector<const Node*> trail = pathOf(word);
+            const Node* old = trail[word.size()];
+            if (old && old->object == object) {
+                return *this;
+            }
+            Node* built = old ? copyNode(old) : new Node();
+            built->object = object;
+            Node* newRoot = copyPath(trail, word, word.size(), built);
+            return PersistentTrie(newRoot, wordCount + (old && old->object ? 0 : 1));
+        }
+
+        /**
+         * @brief Returns a version without @p word (this version if it is not stored).
+         * @details Nodes left without words are not copied into the new version.
+         */
+        [[nodiscard]] PersistentTrie erase(KeyView word) const {
+            std::vector<const Node*> trail = pathOf(word);
+            const Node* old = trail[word.size()];
+            if (!old || !old->object) {
+                return *this;
+            }
+            Node* built = nullptr;
+            if (!old->children.empty()) {
+                built = copyNode(old);
+                built->object = nullptr;
+            }
+            Node* newRoot = copyPath(trail, word, word.size(), built);
+            return PersistentTrie(newRoot, wordCount - 1);
+        }
+
+        /**
+         * @brief Returns the object stored for @p word, or nullptr.
+         */
+        T* wordExists(KeyView word) const {
+            const Node* node = find(word);
+            return node ? node->object : nullptr;
+        }
+
+        /**
+         * @brief Checks whether any word starts with @p prefix.
+         */
+        bool prefixExists(KeyView prefix) const {
+            return find(prefix) != nullptr;
+        }
+
+        /**
+         * @brief Retrieves all objects matching a prefix in lexicographic order.
+         */
+        std::vector<T*> autoComplete(KeyView prefix) const {
+            std::vector<T*> results;
+            forEachCompletion(prefix, [&results](T* obj) { results.push_back(obj); });
+            return results;
+        }
+
+        /**
+         * @brief Retrieves at most @p limit objects matching a prefix in lexicographic order.
+         */
+        std::vector<T*> autoComplete(KeyView prefix, std::size_t limit) const {
+            std::vector<T*> results;
+            if (limit > 0) {
+                forEachCompletion(prefix, [&results, limit](T* obj) {
+                    results.push_back(obj);
+                    return results.size() < limit;
+                });
+            }
+            return results;
+        }
+
+        /**
+         * @brief Calls a function for each object whose word starts with @p prefix.
+         * @tparam Func Callable taking T*. It may return bool; returning false stops the walk.
+         * @return Number of objects passed to @p function.
+         */
+        template<typename Func>
+        std::size_t forEachCompletion(KeyView prefix, Func function) const {
+            std::size_t visited = 0;
+            const Node* start = find(prefix);
+            if (start) {
+                auto step = [&function, &visited](T* obj) {
+                    ++visited;
+                    return invokeVisitor(function, obj);
+                };
+                visitSubtree(start, step);
+            }
+            return visited;
+        }
+
+        /**
+         * @brief Applies a function to all objects in lexicographic order.
+         */
+        template<typename Func>
+        void traverse(Func function) const {
+            if (root) {
+                auto step = [&function](T* obj) {
+                    function(obj);
+                    return true;
+                };
+                visitSubtree(root, step);
+            }
+        }
+
+        /**
+         * @brief Number of words in this version.
+         */
+        std::size_t size() const {
+            return wordCount;
+        }
+
+        bool empty() const {
+            return wordCount == 0;
+        }
+
+        /**
+         * @brief True if both versions share the same root (a cheap identity check).
+         */
+        bool sharesRootWith(const PersistentTrie& other) const {
+            return root == other.root;
+        }
+    };
+
+} // namespace Sefn
@@ -0,0 +1,468 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <new>
+#include <string>
+#include <type_traits>
+#include <vector>
+#include "Trie.hpp"
+#include "detail/Simd.hpp"
+
+/**
+ * @file Sefn/RadixTrie.hpp
+ * @brief Path-compressed (radix / Patricia) prefix tree.
+ */
+
+namespace Sefn {
+
+    /**
+     * @class RadixTrie
+     * @brief A prefix tree whose edges carry whole character runs instead of single characters.
+     *
+     * @details
+     * Chains of single-child nodes collapse into one edge, so keys that share long prefixes
+     * with few branches (URLs, file paths) need far fewer nodes and far fewer pointer hops
+     * per lookup than Trie. Edges are split on insert and merged back on erase.
+     *
+     * The public API mirrors Trie, so the two can be swapped freely.
+     *
+     * @tparam T Type of object to associate with each word.
+     * @tparam Traits Compile-time configuration (see TrieTraits). Children are keyed by the
+     *                first character of each edge label.
+     *
+     * @note Does not take ownership of T* pointers; user is responsible for memory management.
+     *
+     * @example
+     * ```cpp
+     * Sefn::RadixTrie<Route> routes;
+     * routes.insert(&home, "/api/v1/users");
+     * routes.insert(&list, "/api/v1/users/list");  // splits nothing, extends the edge
+     * routes.insert(&items, "/api/v1/items");      // splits "/api/v1/" off the shared edge
+     * ```
+     */
+    template<class T, class Traits = TrieTraits>
+    class RadixTrie {
+    public:
+        /**
+         * @brief Storage policy used for nodes and edge labels.
+         */
+        using Storage = typename Traits::Storage;
+
+    private:
+        struct Node;
+
+        static_assert(std::is_same_v<typename Traits::Key, char>,
+                      "RadixTrie supports char keys only");
+
+        using Children = typename Traits::Children::template Container<char, Node, Storage>;
+
+        /**
+         * @brief A node together with the label of the edge leading into it.
+         */
+        struct Node {
+            /**
+             * @brief Object stored for the word ending at this node, or nullptr.
+             */
+            T* object = nullptr;
+
+            /**
+             * @brief Characters on the edge from the parent to this node (empty for the root).
+             */
+            char* label = nullptr;
+
+            /**
+             * @brief Length of label.
+             */
+            std::uint32_t labelLength = 0;
+
+            /**
+             * @brief Child nodes, keyed by the first character of their label.
+             */
+            Children children;
+
+            explicit Node(Storage* storage) : children(storage) {}
+        };
+
+        /**
+         * @brief Result of walking a key down the tree.
+         */
+        struct Position {
+            /**
+             * @brief Deepest node reached.
+             */
+            const Node* node;
+
+            /**
+             * @brief Number of label characters of @ref node matched by the key.
+             * @details Equal to node->labelLength when the key ends exactly at the node.
+             */
+            std::size_t matched;
+        };
+
+        std::shared_ptr<Storage> storage;
+        Node* root;
+
+        Node* createNode(const char* text, std::size_t length) {
+            void* block = storage->allocate(sizeof(Node), alignof(Node));
+            Node* node = ::new (block) Node(storage.get());
+            setLabel(node, text, length);
+            return node;
+        }
+
+        void destroyNode(Node* node) noexcept {
+            freeLabel(node);
+            node->children.release(storage.get());
+            node->~Node();
+            storage->deallocate(node, sizeof(Node), alignof(Node));
+        }
+
+        void destroySubtree(Node* node) noexcept {
+            std::vector<Node*> pending{node};
+            while (!pending.empty()) {
+                Node* current = pending.back();
+                pending.pop_back();
+                for (auto [key, child] : current->children) {
+                    pending.push_back(child);
+                }
+                destroyNode(current);
+            }
+        }
+
+        void freeLabel(Node* node) noexcept {
+            if (node->label) {
+                storage->deallocate(node->label, node->labelLength, alignof(char));
+                node->label = nullptr;
+            }
+            node->labelLength = 0;
+        }
+
+        /**
+         * @brief Replaces the label of @p node with @p length characters of @p text.
+         * @details @p text may point into the node's current label.
+         */
+        void setLabel(Node* node, const char* text, std::size_t length) {
+            char* label = length ? static_cast<char*>(storage->allocate(length, alignof(char)))
+                                 : nullptr;
+            if (length) {
+                std::memcpy(label, text, length);
+            }
+            freeLabel(node);
+            node->label = label;
+            node->labelLength = static_cast<std::uint32_t>(length);
+        }
+
+        bool canReleaseInBulk() const {
+            return Storage::releasesInBulk && storage.use_count() == 1;
+        }
+
+        static std::size_t commonPrefix(const char* a, const char* b, std::size_t length) {
+            return detail::commonPrefixLength(a, b, length);
+        }
+
+        /**
+         * @brief Walks @p key from the root as far as it matches.
+         * @return The position where the key ended, or a null node if it left the tree.
+         */
+        Position find(KeyView key) const {
+            const Node* current = root;
+            std::size_t index = 0;
+            while (index < key.size()) {
+                const Node* child = current->children.find(key[index]);
+                if (!child) {
+                    return {nullptr, 0};
+                }
+                std::size_t remaining = key.size() - index;
+                std::size_t length = remaining < child->labelLength ? remaining : child->labelLength;
+                std::size_t matched = commonPrefix(child->label, key.data() + index, length);
+                if (matched < length) {
+                    return {nullptr, 0};
+                }
+                index += matched;
+                current = child;
+                if (matched < child->labelLength) {
+                    return {current, matched};
+                }
+            }
+            return {current, current->labelLength};
+        }
+
+        template<typename Func>
+        static void traverseRecursive(const Node* node, Func& function) {
+            if (node->object) {
+                function(node->object);
+            }
+            for (auto [key, child] : node->children) {
+                traverseRecursive(child, function);
+            }
+        }
+
+        /**
+         * @brief Applies a function to objects in the subtree until it asks to stop.
+         * @param function Called with each T* in lexicographic order; returns false to stop.
+         * @return False if the walk was stopped early.
+         */
+        template<typename Func>
+        static bool visitRecursive(const Node* node, Func& function) {
+            if (node->object && !function(node->object)) {
+                return false;
+            }
+            for (auto [key, child] : node->children) {
+                if (!visitRecursive(child, function)) {
+                    return false;
+                }
+            }
+            return true;
+        }
+
+        /**
+         * @brief Adapts a user callback to the bool-returning form used by visitRecursive().
+         * @details Callbacks returning void never stop the walk.
+         */
+        template<typename Func>
+        static bool invokeVisitor(Func& function, T* object) {
+            if constexpr (std::is_void_v<std::invoke_result_t<Func&, T*>>) {
+                function(object);
+                return true;
+            } else {
+                return static_cast<bool>(function(object));
+            }
+        }
+
+        /**
+         * @brief Folds @p node into its only child when it no longer needs to exist on its own.
+         * @param parent Parent of @p node.
+         */
+        void mergeWithChild(Node* parent, Node* node) {
+            if (node == root || node->object || node->children.size() != 1) {
+                return;
+            }
+            Node* child = (*node->children.begin()).second;
+            std::size_t length = node->labelLength + child->labelLength;
+            char* label = static_cast<char*>(storage->allocate(length, alignof(char)));
+            std::memcpy(label, node->label, node->labelLength);
+            std::memcpy(label + node->labelLength, child->label, child->labelLength);
+            freeLabel(child);
+            child->label = label;
+            child->labelLength = static_cast<std::uint32_t>(length);
+
+            char first = node->label[0];
+            parent->children.erase(first, storage.get());
+            parent->children.insert(first, child, storage.get());
+            destroyNode(node);
+        }
+
+    public:
+        /**
+         * @brief Default constructor. The RadixTrie gets a storage of its own.
+         */
+        RadixTrie() : RadixTrie(std::make_shared<Storage>()) {}
+
+        /**
+         * @brief Creates a RadixTrie that allocates nodes and labels from @p storage.
+         */
+        explicit RadixTrie(std::shared_ptr<Storage> storage)
+            : storage(std::move(storage)), root(createNode(nullptr, 0)) {}
+
+        RadixTrie(const RadixTrie&) = delete;
+        RadixTrie& operator=(const RadixTrie&) = delete;
+
+        /**
+         * @brief Destructor. Frees nodes and labels, not the associated objects.
+         */
+        ~RadixTrie() {
+            if (!canReleaseInBulk()) {
+                destroySubtree(root);
+            }
+        }
+
+        /**
+         * @brief Inserts a word with an associated object.
+         * @param object Pointer to associate with the word (not owned).
+         * @param word String to insert.
+         * @note Overwrites the object if the word already exists.
+         */
+        void insert(T* object, KeyView word) {
+            Node* current = root;
+            std::size_t index = 0;
+            while (index < word.size()) {
+                char first = word[index];
+                Node* child = current->children.find(first);
+                std::size_t remaining = word.size() - index;
+                if (!child) {
+                    Node* leaf = createNode(word.data() + index, remaining);
+                    leaf->object = object;
+                    current->children.insert(first, leaf, storage.get());
+                    return;
+                }
+
+                std::size_t length = remaining < child->labelLength ? remaining : child->labelLength;
+                std::size_t matched = commonPrefix(child->label, word.data() + index, length);
+                if (matched < child->labelLength) {
+                    // Split the edge: current -> middle(label[0, matched)) -> child(label[matched, ...))
+                    Node* middle = createNode(child->label, matched);
+                    setLabel(child, child->label + matched, child->labelLength - matched);
+                    middle->children.insert(child->label[0], child, storage.get());
+                    current->children.erase(first, storage.get());
+                    current->children.insert(first, middle, storage.get());
+                    child = middle;
+                }
+                index += matched;
+                current = child;
+            }
+            current->object = object;
+        }
+
+        /**
+         * @brief Removes a word, merging edges that no longer branch.
+         * @param word Word to remove.
+         * @return True if the word was found and removed.
+         * @note Does not deallocate the associated object.
+         */
+        bool erase(KeyView word) {
+            Node* grandparent = nullptr;
+            Node* parent = nullptr;
+            Node* current = root;
+            std::size_t index = 0;
+            while (index < word.size()) {
+                Node* child = current->children.find(word[index]);
+                if (!child || word.size() - index < child->labelLength ||
+                    commonPrefix(child->label, word.data() + index, child->labelLength) !=
+                        child->labelLength) {
+                    return false;
+                }
+                index += child->labelLength;
+                grandparent = parent;
+                parent = current;
+                current = child;
+            }
+            if (!current->object) {
+                return false;
+            }
+            current->object = nullptr;
+
+            if (current == root) {
+                return true;
+            }
+            if (current->children.empty()) {
+                parent->children.erase(current->label[0], storage.get());
+                destroyNode(current);
+                if (grandparent) {
+                    mergeWithChild(grandparent, parent);
+                }
+            } else {
+                mergeWithChild(parent, current);
+            }
+            return true;
+        }
+
+        /**
+         * @brief Checks if a word exists and returns its associated object.
+         * @return Object pointer if found, nullptr otherwise.
+         */
+        T* wordExists(KeyView word) {
+            return const_cast<T*>(static_cast<const RadixTrie*>(this)->wordExists(word));
+        }
+
+        /**
+         * @brief Const overload of wordExists().
+         */
+        const T* wordExists(KeyView word) const {
+            Position position = find(word);
+            return position.node && position.matched == position.node->labelLength
+                       ? position.node->object
+                       : nullptr;
+        }
+
+        /**
+         * @brief Checks if a prefix exists.
+         * @return True if any word starts with this prefix.
+         */
+        bool prefixExists(KeyView prefix) const {
+            return find(prefix).node != nullptr;
+        }
+
+        /**
+         * @brief Applies a function to all objects in lexicographic order.
+         */
+        template<typename Func>
+        void traverse(Func function) const {
+            traverseRecursive(root, function);
+        }
+
+        /**
+         * @brief Retrieves all objects matching a prefix in lexicographic order.
+         */
+        std::vector<T*> autoComplete(KeyView prefix) const {
+            std::vector<T*> results;
+            Position position = find(prefix);
+            if (position.node) {
+                auto collect = [&results](T* obj) { results.push_back(obj); };
+                traverseRecursive(position.node, collect);
+            }
+            return results;
+        }
+
+        /**
+         * @brief Retrieves at most @p limit objects matching a prefix in lexicographic order.
+         * @param prefix String prefix to search for.
+         * @param limit Maximum number of results. The walk stops as soon as it is reached.
+         * @return The first @p limit entries of autoComplete(prefix).
+         */
+        std::vector<T*> autoComplete(KeyView prefix, std::size_t limit) const {
+            std::vector<T*> results;
+            const Node* start = find(prefix).node;
+            if (start && limit > 0) {
+                auto collect = [&results, limit](T* obj) {
+                    results.push_back(obj);
+                    return results.size() < limit;
+                };
+                visitRecursive(start, collect);
+            }
+            return results;
+        }
+
+        /**
+         * @brief Calls a function for each object whose word starts with @p prefix.
+         * @tparam Func Callable taking T*. It may return bool; returning false stops the walk.
+         * @param prefix String prefix to search for.
+         * @param function Called in lexicographic order.
+         * @return Number of objects passed to @p function.
+         */
+        template<typename Func>
+        std::size_t forEachCompletion(KeyView prefix, Func function) const {
+            std::size_t visited = 0;
+            const Node* start = find(prefix).node;
+            if (start) {
+                auto step = [&function, &visited](T* obj) {
+                    ++visited;
+                    return invokeVisitor(function, obj);
+                };
+                visitRecursive(start, step);
+            }
+            return visited;
+        }
+
+        /**
+         * @brief Deallocates all nodes. Does not deallocate associated objects.
+         */
+        void clear() {
+            if (canReleaseInBulk()) {
+                storage->release();
+            } else {
+                destroySubtree(root);
+            }
+            root = createNode(nullptr, 0);
+        }
+
+        /**
+         * @brief Returns the storage nodes are allocated from.
+         */
+        const std::shared_ptr<Storage>& getStorage() const {
+            return storage;
+        }
+    };
+
+} // namespace Sefn
@@ -0,0 +1,400 @@
+#pragma once
+
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <new>
+#include <optional>
+#include <queue>
+#include <string>
+#include <type_traits>
+#include <vector>
+#include "Trie.hpp"
+
+/**
+ * @file Sefn/RankedTrie.hpp
+ * @brief Prefix tree that returns the highest-scoring completions first.
+ */
+
+namespace Sefn {
+
+    /**
+     * @class RankedTrie
+     * @brief A Trie whose words carry a score, answering "best k completions of a prefix".
+     *
+     * @details
+     * Every node caches the maximum score found in its subtree. topK() runs a best-first
+     * search from the prefix node: a priority queue always expands the most promising
+     * subtree next, and subtrees whose cached maximum cannot beat the current k-th candidate
+     * are never entered. Cached maxima are refreshed along the key path on every insert,
+     * score update and erase.
+     *
+     * @tparam T Type of object to associate with each word.
+     * @tparam Score Totally ordered score type (higher ranks first).
+     * @tparam Traits Compile-time configuration (see TrieTraits).
+     *
+     * @note Does not take ownership of T* pointers; user is responsible for memory management.
+     *
+     * @example
+     * ```cpp
+     * Sefn::RankedTrie<std::string> search;
+     * search.insert(&phone, "phone", 950);
+     * search.insert(&photo, "photo", 400);
+     * search.insert(&phase, "phase", 20);
+     * auto best = search.topK("ph", 2);  // phone, photo
+     * ```
+     */
+    template<class T, class Score = double, class Traits = TrieTraits>
+    class RankedTrie {
+    public:
+        /**
+         * @brief Storage policy used for nodes.
+         */
+        using Storage = typename Traits::Storage;
+
+    private:
+        struct Node;
+
+        static_assert(std::is_same_v<typename Traits::Key, char>,
+                      "RankedTrie supports char keys only");
+
+        using Children = typename Traits::Children::template Container<char, Node, Storage>;
+
+        struct Node {
+            /**
+             * @brief Object stored for the word ending at this node, or nullptr.
+             */
+            T* object = nullptr;
+
+            /**
+             * @brief Score of the word ending at this node (meaningful only if object is set).
+             */
+            Score score{};
+
+            /**
+             * @brief Maximum score of any word in this subtree (meaningful only if non-empty).
+             */
+            Score best{};
+
+            Children children;
+
+            explicit Node(Storage* storage) : children(storage) {}
+        };
+
+        /**
+         * @brief Queue entry for topK(): either a subtree to expand or a finished word.
+         */
+        struct Candidate {
+            Score score;
+            const Node* node;
+            bool isWord;
+            std::size_t order;
+
+            bool operator<(const Candidate& other) const {
+                if (score < other.score || other.score < score) {
+                    return score < other.score;
+                }
+                return order > other.order; // Earlier entries win ties
+            }
+        };
+
+        std::shared_ptr<Storage> storage;
+        Node* root;
+
+        /**
+         * @brief Scratch path reused by insert/erase to avoid per-call allocations.
+         */
+        std::vector<Node*> path;
+
+        Node* createNode() {
+            void* block = storage->allocate(sizeof(Node), alignof(Node));
+            return ::new (block) Node(storage.get());
+        }
+
+        void destroyNode(Node* node) noexcept {
+            node->children.release(storage.get());
+            node->~Node();
+            storage->deallocate(node, sizeof(Node), alignof(Node));
+        }
+
+        void destroySubtree(Node* node) noexcept {
+            std::vector<Node*> pending{node};
+            while (!pending.empty()) {
+                Node* current = pending.back();
+                pending.pop_back();
+                for (auto [key, child] : current->children) {
+                    pending.push_back(child);
+                }
+                destroyNode(current);
+            }
+        }
+
+        bool canReleaseInBulk() const {
+            return Storage::releasesInBulk && storage.use_count() == 1;
+        }
+
+        const Node* find(KeyView prefix) const {
+            const Node* current = root;
+            for (char ch : prefix) {
+                current = current->children.find(ch);
+                if (!current) {
+                    return nullptr;
+                }
+            }
+            return current;
+        }
+
+        /**
+         * @brief Recomputes the cached subtree maximum of @p node from its word and children.
+         */
+        static void refreshBest(Node* node) {
+            bool any = node->object != nullptr;
+            Score best = node->score;
+            for (auto [key, child] : node->children) {
+                if (!any || best < child->best) {
+                    best = child->best;
+                    any = true;
+                }
+            }
+            node->best = best;
+        }
+
+        /**
+         * @brief Refreshes cached maxima along the recorded path, deepest node first.
+         */
+        void refreshPath() {
+            for (auto it = path.rbegin(); it != path.rend(); ++it) {
+                refreshBest(*it);
+            }
+        }
+
+        template<typename Func>
+        static void traverseRecursive(const Node* node, Func& function) {
+            if (node->object) {
+                function(node->object);
+            }
+            for (auto [key, child] : node->children) {
+                traverseRecursive(child, function);
+            }
+        }
+
+    public:
+        /**
+         * @brief Default constructor. The RankedTrie gets a storage of its own.
+         */
+        RankedTrie() : RankedTrie(std::make_shared<Storage>()) {}
+
+        /**
+         * @brief Creates a RankedTrie that allocates its nodes from @p storage.
+         */
+        explicit RankedTrie(std::shared_ptr<Storage> storage)
+            : storage(std::move(storage)), root(createNode()) {}
+
+        RankedTrie(const RankedTrie&) = delete;
+        RankedTrie& operator=(const RankedTrie&) = delete;
+
+        /**
+         * @brief Destructor. Frees nodes, not the associated objects.
+         */
+        ~RankedTrie() {
+            if (!canReleaseInBulk()) {
+                destroySubtree(root);
+            }
+        }
+
+        /**
+         * @brief Inserts a word with an associated object and score.
+         * @param object Pointer to associate with the word (not owned).
+         * @param word String to insert.
+         * @param score Ranking score of the word.
+         * @note Overwrites the object and score if the word already exists.
+         */
+        void insert(T *object, KeyView word, Score score) {
+            path.clear();
+            Node* current = root;
+            path.push_back(current);
+            for (char ch : word) {
+                Node* child = current->children.find(ch);
+                if (!child) {
+                    child = createNode();
+                    current->children.insert(ch, child, storage.get());
+                }
+                current = child;
+                path.push_back(current);
+            }
+            current->object = object;
+            current->score = score;
+            if (!object) {
+                // A null object means "no word"; drop any nodes that are now useless
+                erase(word);
+                return;
+            }
+            refreshPath();
+        }
+
+        /**
+         * @brief Changes the score of an existing word.
+         * @return False if the word does not exist.
+         */
+        bool setScore(KeyView word, Score score) {
+            T* object = wordExists(word);
+            if (!object) {
+                return false;
+            }
+            insert(object, word, score);
+            return true;
+        }
+
+        /**
+         * @brief Removes a word and prunes the nodes it alone was using.
+         * @return True if the word was found and removed.
+         */
+        bool erase(KeyView word) {
+            path.clear();
+            Node* current = root;
+            path.push_back(current);
+            for (char ch : word) {
+                current = current->children.find(ch);
+                if (!current) {
+                    return false;
+                }
+                path.push_back(current);
+            }
+            bool existed = current->object != nullptr;
+            if (!existed && !current->children.empty()) {
+                return false;
+            }
+            current->object = nullptr;
+
+            // Prune empty nodes bottom-up
+            std::size_t depth = word.size();
+            while (depth > 0) {
+                Node* node = path[depth];
+                if (node->object || !node->children.empty()) {
+                    break;
+                }
+                path[depth - 1]->children.erase(word[depth - 1], storage.get());
+                destroyNode(node);
+                path.pop_back();
+                --depth;
+            }
+            refreshPath();
+            return existed;
+        }
+
+        /**
+         * @brief Checks if a word exists and returns its associated object.
+         */
+        T* wordExists(KeyView word) {
+            return const_cast<T*>(static_cast<const RankedTrie*>(this)->wordExists(word));
+        }
+
+        /**
+         * @brief Const overload of wordExists().
+         */
+        const T* wordExists(KeyView word) const {
+            const Node* node = find(word);
+            return node ? node->object : nullptr;
+        }
+
+        /**
+         * @brief Returns the score of a word, if it exists.
+         */
+        std::optional<Score> getScore(KeyView word) const {
+            const Node* node = find(word);
+            if (!node || !node->object) {
+                return std::nullopt;
+            }
+            return node->score;
+        }
+
+        /**
+         * @brief Checks if a prefix exists.
+         */
+        bool prefixExists(KeyView prefix) const {
+            return find(prefix) != nullptr;
+        }
+
+        /**
+         * @brief Returns the @p k highest-scoring objects whose words start with @p prefix.
+         * @param prefix String prefix to search for.
+         * @param k Maximum number of results.
+         * @return Objects ordered by descending score. Equal scores keep discovery order.
+         */
+        std::vector<T*> topK(KeyView prefix, std::size_t k) const {
+            std::vector<T*> results;
+            const Node* start = find(prefix);
+            if (!start || k == 0 || (!start->object && start->children.empty())) {
+                return results;
+            }
+
+            std::priority_queue<Candidate> frontier;
+            // Scores of the k best words queued so far; its top is the bar to beat
+            std::priority_queue<Score, std::vector<Score>, std::greater<Score>> kthBest;
+            std::size_t order = 0;
+
+            auto pushWord = [&](const Node* node) {
+                frontier.push({node->score, node, true, order++});
+                kthBest.push(node->score);
+                if (kthBest.size() > k) {
+                    kthBest.pop();
+                }
+            };
+
+            frontier.push({start->best, start, false, order++});
+            while (!frontier.empty() && results.size() < k) {
+                Candidate top = frontier.top();
+                frontier.pop();
+                if (top.isWord) {
+                    results.push_back(top.node->object);
+                    continue;
+                }
+                if (top.node->object) {
+                    pushWord(top.node);
+                }
+                for (auto [key, child] : top.node->children) {
+                    // Skip subtrees that cannot improve on k already-queued words
+                    if (kthBest.size() == k && child->best < kthBest.top()) {
+                        continue;
+                    }
+                    frontier.push({child->best, child, false, order++});
+                }
+            }
+            return results;
+        }
+
+        /**
+         * @brief Applies a function to all objects in lexicographic order.
+         */
+        template<typename Func>
+        void traverse(Func function) const {
+            traverseRecursive(root, function);
+        }
+
+        /**
+         * @brief Retrieves all objects matching a prefix in lexicographic order.
+         */
+        std::vector<T*> autoComplete(KeyView prefix) const {
+            std::vector<T*> results;
+            const Node* start = find(prefix);
+            if (start) {
+                auto collect = [&results](T* obj) { results.push_back(obj); };
+                traverseRecursive(start, collect);
+            }
+            return results;
+        }
+
+        /**
+         * @brief Deallocates all nodes. Does not deallocate associated objects.
+         */
+        void clear() {
+            if (canReleaseInBulk()) {
+                storage->release();
+            } else {
+                destroySubtree(root);
+            }
+            root = createNode();
+        }
+    };
+
+} // namespace Sefn
@@ -0,0 +1,361 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+#include "KeyView.hpp"
+
+/**
+ * @file Sefn/StaticTrie.hpp
+ * @brief Trie over a fixed word list, built at compile time into flat constant tables.
+ */
+
+namespace Sefn {
+
+    namespace detail {
+
+        /**
+         * @brief Node record of a StaticTrie. Nodes are numbered breadth-first, so the children
+         *        of a node are the consecutive records `[firstChild, firstChild + childCount)`.
+         */
+        struct StaticNode {
+            std::uint32_t firstChild = 0;
+            std::uint32_t childCount = 0;
+            std::uint32_t word = 0xFFFFFFFF;
+        };
+
+        constexpr std::uint32_t staticNoWord = 0xFFFFFFFF;
+
+        /**
+         * @brief Not constexpr on purpose: reaching it during constant evaluation makes the
+         *        compiler report a StaticTrie whose NodeCount does not match its words.
+         */
+        inline void staticTrieNodeCountMismatch() {}
+
+        /**
+         * @brief Key order of the tries (`std::less<char>` per element), usable in constexpr.
+         */
+        constexpr bool staticLess(std::string_view a, std::string_view b) {
+            std::size_t length = std::min(a.size(), b.size());
+            for (std::size_t i = 0; i < length; ++i) {
+                if (a[i] != b[i]) {
+                    return a[i] < b[i];
+                }
+            }
+            return a.size() < b.size();
+        }
+
+        constexpr std::size_t staticCommonPrefix(std::string_view a, std::string_view b) {
+            std::size_t length = std::min(a.size(), b.size());
+            std::size_t i = 0;
+            while (i < length && a[i] == b[i]) {
+                ++i;
+            }
+            return i;
+        }
+
+        /**
+         * @brief Indices of @p words in key order (stable bottom-up merge sort, so equal
+         *        words keep their source order).
+         */
+        template<std::size_t N>
+        constexpr std::array<std::size_t, N> staticSortedOrder(
+            const std::string_view (&words)[N]) {
+            std::array<std::size_t, N> order{};
+            std::array<std::size_t, N> merged{};
+            for (std::size_t i = 0; i < N; ++i) {
+                order[i] = i;
+            }
+            for (std::size_t width = 1; width < N; width *= 2) {
+                for (std::size_t low = 0; low < N; low += 2 * width) {
+                    std::size_t middle = std::min(low + width, N);
+                    std::size_t high = std::min(low + 2 * width, N);
+                    std::size_t i = low;
+                    std::size_t j = middle;
+                    std::size_t out = low;
+                    while (i < middle && j < high) {
+                        merged[out++] = staticLess(words[order[j]], words[order[i]]) ? order[j++]
+                                                                                     : order[i++];
+                    }
+                    while (i < middle) {
+                        merged[out++] = order[i++];
+                    }
+                    while (j < high) {
+                        merged[out++] = order[j++];
+                    }
+                }
+                order = merged;
+            }
+            return order;
+        }
+
+    } // namespace detail
+
+    /**
+     * @brief Number of nodes a StaticTrie over @p words needs (the root included).
+     */
+    template<std::size_t N>
+    constexpr std::size_t staticTrieNodeCount(const std::string_view (&words)[N]) {
+        std::array<std::size_t, N> order = detail::staticSortedOrder(words);
+        std::size_t nodes = 1;
+        for (std::size_t k = 0; k < N; ++k) {
+            std::string_view word = words[order[k]];
+            nodes += word.size() -
+                     (k > 0 ? detail::staticCommonPrefix(word, words[order[k - 1]]) : 0);
+        }
+        return nodes;
+    }
+
+    /**
+     * @class StaticTrie
+     * @brief Read-only Trie over a word list known at compile time.
+     *
+     * @details The constructor is constexpr, so a StaticTrie declared `constexpr` is built by
+     * the compiler: there is no startup cost, the tables are placed in read-only data (shared
+     * between processes mapping the same binary) and queries on constants can be
+     * `static_assert`ed. Nodes are 12-byte records in breadth-first order with the edge labels
+     * in a separate byte array, as in FrozenTrie.
+     *
+     * A word's value is its index in the source array, so the array can be kept parallel to an
+     * enum. If a word is listed more than once, its first index is used.
+     *
+     * @tparam WordCount Number of entries in the source array.
+     * @tparam NodeCount Must equal `staticTrieNodeCount(words)`; makeStaticTrie() fills it in.
+     *
+     * @example
+     * ```cpp
+     * constexpr std::string_view httpMethods[] = {"GET", "HEAD", "POST", "PUT", "DELETE"};
+     * constexpr auto methods = Sefn::makeStaticTrie<httpMethods>();
+     * static_assert(methods.indexOf("POST") == 2);
+     * ```
+     */
+    template<std::size_t WordCount, std::size_t NodeCount>
+    class StaticTrie {
+    public:
+        /**
+         * @brief Returned by indexOf() for absent words.
+         */
+        static constexpr std::size_t npos = static_cast<std::size_t>(-1);
+
+        /**
+         * @brief Builds the tables from @p source. The views must outlive the StaticTrie
+         *        (string literals do).
+         */
+        explicit constexpr StaticTrie(const std::string_view (&source)[WordCount]) {
+            std::array<std::size_t, WordCount> order = detail::staticSortedOrder(source);
+            // shared[k]: common prefix of the k-th sorted word with the one before it
+            std::array<std::size_t, WordCount> shared{};
+            std::size_t longest = 0;
+            for (std::size_t k = 0; k < WordCount; ++k) {
+                words[k] = source[k];
+                std::string_view word = source[order[k]];
+                shared[k] = k > 0 ? detail::staticCommonPrefix(word, source[order[k - 1]]) : 0;
+                longest = std::max(longest, word.size());
+            }
+            if (WordCount > 0 && source[order[0]].empty()) {
+                nodes[0].word = static_cast<std::uint32_t>(order[0]);
+                wordCount = 1;
+            }
+
+            // Level by level, the new prefixes of length `depth` appear in key order: the
+            // sorted words whose first `depth` elements differ from their predecessor's.
+            // Their parents are then met in order too, so one cursor per level finds them.
+            std::array<std::size_t, NodeCount> origin{};
+            std::size_t count = 1;
+            std::size_t levelStart = 0;
+            for (std::size_t depth = 1; depth <= longest; ++depth) {
+                std::size_t parent = levelStart;
+                levelStart = count;
+                for (std::size_t k = 0; k < WordCount; ++k) {
+                    std::string_view word = source[order[k]];
+                    if (word.size() < depth || shared[k] >= depth) {
+                        continue;
+                    }
+                    while (depth > 1 &&
+                           detail::staticCommonPrefix(source[order[origin[parent]]], word) <
+                               depth - 1) {
+                        ++parent;
+                    }
+                    if (count == NodeCount) {
+                        detail::staticTrieNodeCountMismatch();
+                        return;
+                    }
+                    std::size_t node = count++;
+                    origin[node] = k;
+                    labels[node] = word[depth - 1];
+                    if (nodes[parent].childCount++ == 0) {
+                        nodes[parent].firstChild = static_cast<std::uint32_t>(node);
+                    }
+                    if (word.size() == depth) {
+                        nodes[node].word = static_cast<std::uint32_t>(order[k]);
+                        ++wordCount;
+                    }
+                }
+            }
+            if (count != NodeCount) {
+                detail::staticTrieNodeCountMismatch();
+            }
+        }
+
+        /**
+         * @brief Number of distinct words.
+         */
+        constexpr std::size_t size() const {
+            return wordCount;
+        }
+
+        static constexpr std::size_t nodeCount() {
+            return NodeCount;
+        }
+
+        /**
+         * @brief Index of @p word in the source array, or npos if it is absent.
+         */
+        constexpr std::size_t indexOf(KeyView word) const {
+            std::size_t node = find(word);
+            if (node == npos || nodes[node].word == detail::staticNoWord) {
+                return npos;
+            }
+            return nodes[node].word;
+        }
+
+        /**
+         * @brief Checks if a word exists.
+         */
+        constexpr bool wordExists(KeyView word) const {
+            return indexOf(word) != npos;
+        }
+
+        /**
+         * @brief Checks if any word starts with @p prefix.
+         */
+        constexpr bool prefixExists(KeyView prefix) const {
+            return find(prefix) != npos;
+        }
+
+        /**
+         * @brief The source word at @p index.
+         */
+        constexpr std::string_view wordAt(std::size_t index) const {
+            return words[index];
+        }
+
+        /**
+         * @brief Retrieves the words starting with @p prefix, in lexicographic order.
+         */
+        std::vector<std::string_view> autoComplete(KeyView prefix) const {
+            std::vector<std::string_view> results;
+            forEachCompletion(prefix, [&results](std::string_view word, std::size_t) {
+                results.push_back(word);
+            });
+            return results;
+        }
+
+        /**
+         * @brief Retrieves at most @p limit words starting with @p prefix.
+         */
+        std::vector<std::string_view> autoComplete(KeyView prefix, std::size_t limit) const {
+            std::vector<std::string_view> results;
+            if (limit == 0) {
+                return results;
+            }
+            forEachCompletion(prefix, [&results, limit](std::string_view word, std::size_t) {
+                results.push_back(word);
+                return results.size() < limit;
+            });
+            return results;
+        }
+
+        /**
+         * @brief Streams the words starting with @p prefix, in lexicographic order.
+         * @param function Called with `(std::string_view word, std::size_t index)`; may return
+         *        bool, false stops the walk.
+         * @return Number of words passed to @p function.
+         */
+        template<typename Func>
+        constexpr std::size_t forEachCompletion(KeyView prefix, Func function) const {
+            std::size_t node = find(prefix);
+            std::size_t visited = 0;
+            if (node != npos) {
+                visitSubtree(node, function, visited);
+            }
+            return visited;
+        }
+
+    private:
+        std::array<std::string_view, WordCount> words{};
+        std::array<detail::StaticNode, NodeCount> nodes{};
+        std::array<char, NodeCount> labels{};
+        std::size_t wordCount = 0;
+
+        constexpr std::size_t find(KeyView prefix) const {
+            std::size_t current = 0;
+            for (char ch : prefix) {
+                const detail::StaticNode& node = nodes[current];
+                std::size_t child = node.firstChild;
+                std::size_t last = child + node.childCount;
+                while (child < last && labels[child] != ch) {
+                    ++child;
+                }
+                if (child == last) {
+                    return npos;
+                }
+                current = child;
+            }
+            return current;
+        }
+
+        /**
+         * @brief Depth-first walk in key order; recursion depth is the longest word length.
+         * @return False once @p function asked to stop.
+         */
+        template<class Func>
+        constexpr bool visitSubtree(std::size_t node, Func& function, std::size_t& visited) const {
+            if (nodes[node].word != detail::staticNoWord) {
+                ++visited;
+                if (!invokeVisitor(function, nodes[node].word)) {
+                    return false;
+                }
+            }
+            std::size_t first = nodes[node].firstChild;
+            for (std::size_t child = first; child < first + nodes[node].childCount; ++child) {
+                if (!visitSubtree(child, function, visited)) {
+                    return false;
+                }
+            }
+            return true;
+        }
+
+        template<class Func>
+        constexpr bool invokeVisitor(Func& function, std::size_t index) const {
+            if constexpr (std::is_void_v<
+                              std::invoke_result_t<Func&, std::string_view, std::size_t>>) {
+                function(words[index], index);
+                return true;
+            } else {
+                return static_cast<bool>(function(words[index], index));
+            }
+        }
+    };
+
+    /**
+     * @brief Builds the StaticTrie of a `constexpr std::string_view` array with static
+     *        storage duration, working out both size parameters.
+     *
+     * @example
+     * ```cpp
+     * constexpr std::string_view sqlKeywords[] = {"SELECT", "FROM", "WHERE", "ORDER", "BY"};
+     * constexpr auto keywords = Sefn::makeStaticTrie<sqlKeywords>();
+     * ```
+     */
+    template<const auto& words>
+    constexpr auto makeStaticTrie() {
+        return StaticTrie<std::size(words), staticTrieNodeCount(words)>(words);
+    }
+
+} // namespace Sefn
@@ -1,10 +1,27 @@
 #pragma once
 
-#include <map>
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
 #include <iostream>
+#include <iterator>
+#include <limits>
+#include <memory>
+#include <new>
+#include <stdexcept>
 #include <vector>
 #include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
 #include <functional>
+#include "KeyView.hpp"
+#include "NodeStorage.hpp"
+#include "TrieChildren.hpp"
+#include "detail/FlatHash.hpp"
+#include "detail/Parallel.hpp"
+#include "detail/Prefetch.hpp"
+#include "detail/Wildcard.hpp"
 
 /**
  * @file Sefn/Trie.hpp
@@ -12,6 +29,290 @@
  */
 
 namespace Sefn {
+
+    /**
+     * @struct TrieTraits
+     * @brief Default compile-time configuration for Trie.
+     *
+     * @details Derive from this struct and override members to customize a Trie:
+     * ```cpp
+     * struct MyTraits : Sefn::TrieTraits {
+     *     using Storage = Sefn::PoolStorage;
+     * };
+     * Sefn::Trie<int, MyTraits> trie;
+     * ```
+     */
+    struct TrieTraits {
+        /**
+         * @brief Storage policy for nodes (see Sefn/NodeStorage.hpp).
+         */
+        using Storage = HeapStorage;
+
+        /**
+         * @brief Child-container policy for nodes (see Sefn/TrieChildren.hpp).
+         */
+        using Children = MapChildren;
+
+        /**
+         * @brief Element type of keys. Any totally ordered type; `char` gives string keys.
+         */
+        using Key = char;
+
+        /**
+         * @brief When true the Trie stores values inline in its nodes and owns them
+         *        (see TrieMap); when false it indexes caller-owned T* objects.
+         */
+        static constexpr bool ownsValues = false;
+
+        /**
+         * @brief When true every node keeps the number of words in its subtree, which
+         *        countPrefix(), rank() and select() use instead of walking the subtree.
+         */
+        static constexpr bool countsWords = false;
+
+        /**
+         * @brief When true the Trie counts lookups, visited nodes and node allocations
+         *        (see counters()). When false the hooks compile to nothing.
+         */
+        static constexpr bool recordsCounters = false;
+
+        /**
+         * @brief When true the Trie also keeps a flat hash index from whole words to their
+         *        nodes, so wordExists() is one hash probe instead of one descent per element.
+         */
+        static constexpr bool hashesWords = false;
+    };
+
+    /**
+     * @struct PooledTrieTraits
+     * @brief Trie configuration that allocates nodes from a slab pool.
+     */
+    struct PooledTrieTraits : TrieTraits {
+        using Storage = PoolStorage;
+    };
+
+    /**
+     * @struct BitTrieTraits
+     * @brief Keys are sequences of bits (elements 0 or 1), e.g. IP routing prefixes.
+     * @details Inserting a key with other elements throws std::invalid_argument; queries
+     *          with them find nothing.
+     */
+    struct BitTrieTraits : TrieTraits {
+        using Key = std::uint8_t;
+        using Children = FixedArrayChildren<2>;
+    };
+
+    /**
+     * @struct NibbleTrieTraits
+     * @brief Keys are sequences of nibbles (elements 0-15), e.g. hex-digit IPv6 prefixes.
+     * @details Inserting a key with elements of 16 or more throws std::invalid_argument;
+     *          queries with them find nothing.
+     */
+    struct NibbleTrieTraits : TrieTraits {
+        using Key = std::uint8_t;
+        using Children = FixedArrayChildren<16>;
+    };
+
+    /**
+     * @struct ByteTrieTraits
+     * @brief Keys are sequences of raw bytes (elements 0-255) with inline 256-entry nodes.
+     */
+    struct ByteTrieTraits : TrieTraits {
+        using Key = std::uint8_t;
+        using Children = FixedArrayChildren<256>;
+    };
+
+    /**
+     * @struct OwningTraits
+     * @brief Turns any traits struct into its value-owning variant.
+     */
+    template<class Base = TrieTraits>
+    struct OwningTraits : Base {
+        static constexpr bool ownsValues = true;
+    };
+
+    /**
+     * @struct CountingTraits
+     * @brief Turns any traits struct into a variant that keeps per-node subtree word counts.
+     * @details Costs one word per node and one counter update per node on the path of
+     *          each insertion or removal.
+     */
+    template<class Base = TrieTraits>
+    struct CountingTraits : Base {
+        static constexpr bool countsWords = true;
+    };
+
+    /**
+     * @struct InstrumentedTraits
+     * @brief Turns any traits struct into a variant that records hot-path counters.
+     */
+    template<class Base = TrieTraits>
+    struct InstrumentedTraits : Base {
+        static constexpr bool recordsCounters = true;
+    };
+
+    /**
+     * @struct HashedTraits
+     * @brief Turns any traits struct into a variant with an exact-match hash index.
+     * @details Costs one slot (hash, node pointer and a copy of the word) per word and one
+     *          index update per insertion or removal; prefix queries still walk the tree.
+     *          Keys must be characters or integers.
+     */
+    template<class Base = TrieTraits>
+    struct HashedTraits : Base {
+        static constexpr bool hashesWords = true;
+    };
+
+    /**
+     * @struct TrieStats
+     * @brief Shape and memory footprint of a Trie (or one prefix subtree), from Trie::stats().
+     * @details Byte counts are what the Trie requests from its storage and child containers;
+     *          allocator headers and pool slack are not included.
+     */
+    struct TrieStats {
+        /**
+         * @brief Number of nodes, the subtree root included.
+         */
+        std::size_t nodes = 0;
+
+        /**
+         * @brief Number of stored words.
+         */
+        std::size_t words = 0;
+
+        /**
+         * @brief Bytes of the node objects themselves.
+         */
+        std::size_t nodeBytes = 0;
+
+        /**
+         * @brief Bytes of child edges held outside the nodes (map nodes, arrays, tables).
+         */
+        std::size_t edgeBytes = 0;
+
+        /**
+         * @brief Part of nodeBytes spent on values: the object pointer of every node, plus
+         *        the inline value buffer in owning mode.
+         */
+        std::size_t valueBytes = 0;
+
+        /**
+         * @brief `fanout[k]` is the number of nodes with k children.
+         */
+        std::vector<std::size_t> fanout;
+
+        /**
+         * @brief `depth[d]` is the number of nodes d edges below the subtree root.
+         */
+        std::vector<std::size_t> depth;
+
+        /**
+         * @brief `chains[n]` is the number of maximal runs of n consecutive nodes that have a
+         *        single child and no word (what a RadixTrie would merge into one edge).
+         */
+        std::vector<std::size_t> chains;
+
+        /**
+         * @brief Bytes of the exact-match index (HashedTraits, whole-Trie stats only).
+         */
+        std::size_t indexBytes = 0;
+
+        /**
+         * @brief nodeBytes + edgeBytes + indexBytes.
+         */
+        std::size_t totalBytes() const {
+            return nodeBytes + edgeBytes + indexBytes;
+        }
+    };
+
+    /**
+     * @struct TrieCounters
+     * @brief Hot-path event counts of a Trie with `Traits::recordsCounters`.
+     */
+    struct TrieCounters {
+        /**
+         * @brief Key walks from the root: every prefix/word query and each lookupBatch() key.
+         *        A hash probe of a HashedTraits lookup counts as a walk visiting no nodes.
+         */
+        std::uint64_t lookups = 0;
+
+        /**
+         * @brief Child lookups made by those walks.
+         */
+        std::uint64_t nodesVisited = 0;
+
+        /**
+         * @brief Nodes allocated, including the root of a new or cleared Trie.
+         */
+        std::uint64_t allocations = 0;
+
+        /**
+         * @brief Nodes freed one at a time (storage bulk releases are not counted).
+         */
+        std::uint64_t deallocations = 0;
+    };
+
+    namespace detail {
+
+        /**
+         * @brief Inline value buffer of an owning Trie node; empty for non-owning tries.
+         */
+        template<class T, bool owning>
+        struct NodeValue {};
+
+        template<class T>
+        struct NodeValue<T, true> {
+            alignas(T) unsigned char buffer[sizeof(T)];
+
+            void* valueSlot() {
+                return buffer;
+            }
+        };
+
+        /**
+         * @brief Subtree word count of a counting Trie node; empty otherwise.
+         */
+        template<bool counting>
+        struct NodeCount {};
+
+        template<>
+        struct NodeCount<true> {
+            std::size_t words = 0;
+        };
+
+        /**
+         * @brief Counter hooks of the Trie; no-ops unless @p enabled.
+         */
+        template<bool enabled>
+        struct CounterSet {
+            void lookup(std::size_t) const noexcept {}
+            void allocated(std::size_t) const noexcept {}
+            void deallocated() const noexcept {}
+        };
+
+        /**
+         * @brief Recording variant. Counters are mutable so const queries can update them;
+         *        a Trie read from several threads at once must not record counters.
+         */
+        template<>
+        struct CounterSet<true> {
+            mutable TrieCounters values;
+
+            void lookup(std::size_t steps) const noexcept {
+                ++values.lookups;
+                values.nodesVisited += steps;
+            }
+
+            void allocated(std::size_t nodes) const noexcept {
+                values.allocations += nodes;
+            }
+
+            void deallocated() const noexcept {
+                ++values.deallocations;
+            }
+        };
+
+    } // namespace detail
     
     /**
      * @class Trie
@@ -26,10 +327,16 @@ namespace Sefn {
      * - Lexicographic ordering: Results are naturally sorted.
      *
      * @tparam T Type of object to associate with each word.
+     * @tparam Traits Compile-time configuration (see TrieTraits).
      *
      * @note
      * - Does not take ownership of T* pointers; user is responsible for memory management.
-     * - Uses std::map<char, Trie*> for efficient navigation.
+     *   With `Traits::ownsValues` (see TrieMap) values live inside the nodes instead and are
+     *   destroyed by erase(), clear() and the destructor.
+     * - Child edges are stored according to Traits::Children: std::map by default, or a
+     *   sorted vector, direct table or adaptive layout. All of them keep lexicographic order.
+     * - Nodes come from Traits::Storage. With PoolStorage, clear() and destruction
+     *   release all nodes in O(slabs) instead of freeing them one by one.
      *
      * @example
      * ```cpp
@@ -58,220 +365,2058 @@ namespace Sefn {
      * delete help;
      * ```
      */
-    template<class T>
+    template<class T, class Traits = TrieTraits>
     class Trie {
+    public:
+        /**
+         * @brief Storage policy used for nodes.
+         */
+        using Storage = typename Traits::Storage;
+
+        /**
+         * @brief Element type of keys.
+         */
+        using Key = typename Traits::Key;
+
+        /**
+         * @brief Key parameter type; binds strings, views and contiguous ranges of Key.
+         */
+        using KeyView = BasicKeyView<Key>;
+
+        /**
+         * @brief Key type handed out by iterators and key-reconstructing callbacks
+         *        (std::string_view for char keys).
+         */
+        using KeyStringView = detail::KeyStringView<Key>;
+
+        /**
+         * @brief True if values are stored inline and owned by the Trie.
+         */
+        static constexpr bool ownsValues = Traits::ownsValues;
+
+        /**
+         * @brief True if nodes keep subtree word counts (see CountingTraits).
+         */
+        static constexpr bool countsWords = Traits::countsWords;
+
+        /**
+         * @brief True if the Trie records hot-path counters (see InstrumentedTraits).
+         */
+        static constexpr bool recordsCounters = Traits::recordsCounters;
+
+        /**
+         * @brief True if exact lookups go through a hash index (see HashedTraits).
+         */
+        static constexpr bool hashesWords = Traits::hashesWords;
+
     private:
+        struct Node;
+
+        using Children = typename Traits::Children::template Container<Key, Node, Storage>;
+
+        /**
+         * @brief Owning key buffer (std::string for char keys).
+         */
+        using KeyString = detail::KeyString<Key>;
+
         /**
-         * @brief Pointer to the object associated with this node if it represents a complete word.
-         * @details nullptr if this node is not an end-of-word marker.
+         * @brief A single Trie node.
          */
-        T* object = nullptr;
+        struct Node : detail::NodeValue<T, ownsValues>, detail::NodeCount<countsWords> {
+            /**
+             * @brief Pointer to the object associated with this node if it represents a complete word.
+             * @details nullptr if this node is not an end-of-word marker. In owning mode it
+             *          points into the node's own value buffer.
+             */
+            T* object = nullptr;
+
+            /**
+             * @brief Child nodes, keyed by character.
+             */
+            Children children;
+
+            explicit Node(Storage* storage) : children(storage) {}
+        };
 
         /**
-         * @brief Map of child nodes, keyed by character.
+         * @brief Memory source for nodes; may be shared with other tries.
          */
-        std::map<char, Trie*> children;
+        std::shared_ptr<Storage> storage;
 
         /**
-         * @brief Locates the node for a given prefix.
-         * @param prefix String to search for.
-         * @return Const pointer to the node, or nullptr if not found.
+         * @brief Hot-path counters; empty unless recordsCounters. Declared before root so
+         *        the root's allocation is counted.
          */
-        const Trie* find(const std::string &prefix) const {
-            const Trie* current = this;
-            for (char ch : prefix) {
-                auto it = current->children.find(ch);
-                if (it == current->children.cend()) {
-                    return nullptr;
-                }
-                current = it->second;
-            }
-            return current;
-        }
+        detail::CounterSet<recordsCounters> events;
 
         /**
-         * @brief Non-const overload of find().
+         * @brief Node representing the empty prefix.
+         */
+        Node* root;
+
+        /**
+         * @brief Scratch path reused by the bulk and erase operations to avoid per-call allocations.
+         */
+        std::vector<Node*> path;
+
+        /**
+         * @brief Word -> node index; empty unless hashesWords. Holds exactly the stored words.
+         */
+        detail::WordIndex<hashesWords, Key, Node> index;
+
+        /**
+         * @brief Allocates and constructs an empty node from the storage.
          */
-        Trie* find(const std::string &prefix) {
-            return const_cast<Trie*>(static_cast<const Trie*>(this)->find(prefix));
+        Node* createNode() {
+            events.allocated(1);
+            return createNode(storage.get());
         }
 
         /**
-         * @brief Collects all objects in this subtree.
+         * @brief Allocates and constructs an empty node from @p from (a per-thread arena while
+         *        building in parallel).
          */
-        void getAllObjects(std::vector<T*> &results) const {
-            this->traverseRecursive([&results](T* obj) {
-                results.push_back(obj);
-            });
+        static Node* createNode(Storage* from) {
+            void* block = from->allocate(sizeof(Node), alignof(Node));
+            return ::new (block) Node(from);
         }
 
         /**
-         * @brief Applies a function to each object in the subtree.
-         * @tparam Func Callable type.
-         * @param function Called with each T* object.
+         * @brief Destroys a single node and returns its memory to the storage.
          */
-        template<typename Func>
-        void traverseRecursive(Func function) const {
-            if (object) {
-                function(object);
-            }
-            for (auto const& [key, child] : children) {
-                child->traverseRecursive(function);
-            }
+        void destroyNode(Node* node) noexcept {
+            destroyValue(node);
+            node->children.release(storage.get());
+            node->~Node();
+            storage->deallocate(node, sizeof(Node), alignof(Node));
+            events.deallocated();
         }
 
         /**
-         * @brief Removes a word from the Trie (internal recursive helper).
-         * @param word Word to remove.
-         * @param index Current character index in the word.
-         * @return True if this node and its subtree can be deleted, false otherwise.
+         * @brief Ends the word at @p node; in owning mode also destroys its value.
          */
-        bool removeRecursive(const std::string &word, int index = 0) {
-            if (index == word.size()) {
-                // Reached end of word - clear the marker
-                if (!object) {
-                    return false; // Word doesn't exist
+        void destroyValue(Node* node) noexcept {
+            if constexpr (ownsValues) {
+                if (node->object) {
+                    node->object->~T();
                 }
-                object = nullptr;
-                // Return true if this node has no children (can be deleted)
-                return children.empty();
             }
+            node->object = nullptr;
+        }
 
-            char ch = word[index];
-            auto it = children.find(ch);
-            if (it == children.end()) {
-                return false; // Character doesn't exist, word not in Trie
+        /**
+         * @brief Adds @p delta to the subtree word counts of @p count nodes; no-op unless
+         *        countsWords.
+         */
+        static void countWords(Node* const* nodes, std::size_t count,
+                               std::ptrdiff_t delta) noexcept {
+            if constexpr (countsWords) {
+                for (std::size_t i = 0; i < count; ++i) {
+                    nodes[i]->words += static_cast<std::size_t>(delta);
+                }
             }
+        }
 
-            Trie* child = it->second;
-            bool canDeleteChild = child->removeRecursive(word, index + 1);
-
-            // If child can be deleted, remove it
-            if (canDeleteChild) {
-                delete child;
-                children.erase(it);
-                // Return true if this node has no object and no children
-                return object == nullptr && children.empty();
+        /**
+         * @brief Words in the subtree of @p node; 0 unless countsWords.
+         */
+        static std::ptrdiff_t wordsBelow(const Node* node) noexcept {
+            if constexpr (countsWords) {
+                return static_cast<std::ptrdiff_t>(node->words);
+            } else {
+                (void)node;
+                return 0;
             }
-
-            return false;
         }
-    public:
+
         /**
-         * @brief Default constructor.
+         * @brief Stores @p value as the word object of @p node.
+         * @details Non-owning: @p value is a T* and replaces the pointer. Owning: @p value is
+         *          assigned to the existing value or constructs a new one in the node.
          */
-        Trie() = default;
+        template<class V>
+        void assignValue(Node* node, V&& value) {
+            if constexpr (ownsValues) {
+                if (node->object) {
+                    *node->object = std::forward<V>(value);
+                } else {
+                    node->object = ::new (node->valueSlot()) T(std::forward<V>(value));
+                }
+            } else {
+                node->object = value;
+            }
+        }
 
         /**
-         * @brief Copy constructor is deleted to prevent shallow copies and double frees.
+         * @brief assignValue() that also adds @p word to, or drops it from, the index.
          */
-        Trie(const Trie &) = delete;
+        template<class V>
+        void assignWord(Node* node, KeyView word, V&& value) {
+            const bool existed = node->object != nullptr;
+            if (!existed) {
+                index.add(word, node);
+            }
+            try {
+                assignValue(node, std::forward<V>(value));
+            } catch (...) {
+                if (!existed) {
+                    index.remove(word);
+                }
+                throw;
+            }
+            if (!node->object) {
+                index.remove(word);  // A null object stores no word
+            }
+        }
 
         /**
-         * @brief Copy assignment operator is deleted to prevent shallow copies.
+         * @brief Moves the index entries of words that merge() took from @p other.
+         * @details A spliced subtree keeps its nodes; a word whose value moved into an
+         *          existing node here is found under that node. Does not allocate because
+         *          merge() reserved room for all of @p other's entries.
          */
-        Trie &operator=(const Trie&) = delete;
+        void adoptIndexEntries(Trie& other) noexcept {
+            if constexpr (hashesWords) {
+                other.index.extractIf([this](KeyString& key, Node* node) {
+                    Node* mine = find(KeyView(key));
+                    if (mine != node && (node->object || !mine || !mine->object)) {
+                        return false;  // Still only stored in other (or kept here as a duplicate)
+                    }
+                    index.add(std::move(key), mine);
+                    return true;
+                });
+            }
+        }
 
         /**
-         * @brief Destructor. Frees the memory allocated for child nodes.
-         * @note This does NOT deallocate the `T* object` pointers.
+         * @brief Throws std::invalid_argument if @p word has an element the Children policy
+         *        cannot store (see FixedArrayChildren); called before any node is created.
          */
-        ~Trie() {
-            clear();
+        static void checkStorable(KeyView word) {
+            if constexpr (detail::HasKeyFilter<Children, Key>::value) {
+                for (Key element : word) {
+                    if (!Children::accepts(element)) {
+                        throw std::invalid_argument("Trie: key element outside the alphabet");
+                    }
+                }
+            }
         }
 
         /**
-         * @brief Inserts a word with an associated object.
-         * @param object Pointer to associate with the word (not owned by Trie).
-         * @param word String to insert.
-         * @note Overwrites the object if the word already exists.
+         * @brief Returns the node for @p word, creating missing nodes; records them in `path`.
          */
-        void insert(T *object, const std::string &word) {
-            Trie* current = this;
-            for (char ch : word) {
-                Trie* &child = current->children[ch];
+        Node* findOrCreatePath(KeyView word) {
+            path.assign(1, root);
+            Node* current = root;
+            for (Key ch : word) {
+                Node* child = current->children.find(ch);
                 if (!child) {
-                    child = new Trie;
+                    child = createNode();
+                    current->children.insert(ch, child, storage.get());
                 }
                 current = child;
+                path.push_back(current);
             }
-            current->object = object;
+            return current;
         }
 
         /**
-         * @brief Removes a word from the Trie.
-         * @param word Word to remove.
-         * @return True if word was found and removed, false if word doesn't exist.
-         * @note Does not deallocate the associated object; user must manage that.
-         *       Automatically cleans up empty nodes after removal.
+         * @brief Shared body of buildFromSorted() and buildFromUnsorted().
+         * @param entryOf Maps an iterator to its pair-like (word, value) element.
          */
-        bool erase(const std::string &word) {
-            if(!wordExists(word)) {
-                return false;
-            }
-            removeRecursive(word);
-            return true;
+        template<class It, class EntryOf>
+        void buildSorted(It first, It last, EntryOf entryOf) {
+            events.allocated(buildSortedBelow(root, 0, first, last, entryOf, storage.get(), path));
         }
 
         /**
-         * @brief Checks if a word exists and returns its associated object.
-         * @param word Word to search for.
-         * @return Object pointer if found, nullptr otherwise.
+         * @brief Inserts sorted entries whose words all start with the @p depth key elements
+         *        leading to @p start.
+         * @details Touches only @p start's subtree, @p from and @p trail, so workers of
+         *          buildParallel() can fill disjoint subtrees concurrently.
+         * @param trail Scratch path, the counterpart of `path`.
+         * @return Number of nodes created.
          */
-        T* wordExists(const std::string &word) {
-            return const_cast<T*>(static_cast<const Trie*>(this)->wordExists(word));
+        template<class It, class EntryOf>
+        std::size_t buildSortedBelow(Node* start, std::size_t depth, It first, It last,
+                                     EntryOf entryOf, Storage* from, std::vector<Node*>& trail) {
+            std::size_t created = 0;
+            KeyString previous;
+            trail.assign(1, start);
+            for (; first != last; ++first) {
+                auto&& entry = entryOf(first);
+                KeyView word(entry.first);
+                checkStorable(word);
+                std::size_t common = depth;
+                std::size_t limit = std::min(previous.size(), word.size());
+                while (common < limit && previous[common] == word[common]) {
+                    ++common;
+                }
+                trail.resize(common - depth + 1);
+                Node* current = trail.back();
+                for (std::size_t i = common; i < word.size(); ++i) {
+                    Node* child = current->children.find(word[i]);
+                    if (!child) {
+                        child = createNode(from);
+                        current->children.insert(word[i], child, from);
+                        ++created;
+                    }
+                    current = child;
+                    trail.push_back(current);
+                }
+                const bool existed = current->object != nullptr;
+                assignWord(current, word, entry.second);
+                countWords(trail.data(), trail.size(),
+                           std::ptrdiff_t(current->object != nullptr) - std::ptrdiff_t(existed));
+                previous.assign(word.begin(), word.end());
+            }
+            return created;
         }
 
         /**
-         * @brief Const overload of wordExists().
+         * @brief Destroys @p node and all of its descendants.
+         * @details Iterative so that very long keys cannot overflow the call stack.
          */
-        const T* wordExists(const std::string &word) const {
-            const Trie *current = find(word);
-            return current && current->object ? current->object : nullptr;
+        void destroySubtree(Node* node) noexcept {
+            std::vector<Node*> pending{node};
+            while (!pending.empty()) {
+                Node* current = pending.back();
+                pending.pop_back();
+                for (auto [key, child] : current->children) {
+                    pending.push_back(child);
+                }
+                destroyNode(current);
+            }
         }
 
         /**
-         * @brief Checks if a prefix exists.
-         * @param prefix Prefix to search for.
-         * @return True if any word starts with this prefix.
+         * @brief Hands the per-worker arenas of buildParallel() to the Trie's storage.
          */
-        bool prefixExists(const std::string &prefix) const {
-            return find(prefix) != nullptr;
+        void adoptArenas(std::vector<std::unique_ptr<Storage>>& arenas) {
+            if constexpr (detail::CanAdoptStorage<Storage>::value) {
+                for (auto& arena : arenas) {
+                    storage->adopt(std::move(arena));
+                }
+            }
         }
 
         /**
-         * @brief Applies a function to all objects in the Trie.
-         * @tparam Func Callable type.
-         * @param function Called with each T* in the Trie in lexicographic order.
+         * @brief True when all nodes can be dropped by releasing the storage at once.
+         * @details Only allowed when no other trie shares the storage, and never when owned
+         *          values still need their destructors to run.
          */
-        template<typename Func>
-        void traverse(Func function) const {
-            this->traverseRecursive(function);
+        bool canReleaseInBulk() const {
+            return Storage::releasesInBulk && storage.use_count() == 1 &&
+                   (!ownsValues || std::is_trivially_destructible_v<T>);
         }
 
         /**
-         * @brief Retrieves all objects matching a prefix in lexicographic order.
-         * @param prefix String prefix to search for.
-         * @return Vector of pointers to matching objects, sorted lexicographically.
+         * @brief Locates the node for a given prefix.
+         * @param prefix String to search for.
+         * @return Const pointer to the node, or nullptr if not found.
          */
-        std::vector<T*> autoComplete(const std::string &prefix) const {
-            std::vector<T*> results;
-            const Trie* root = find(prefix);
-            if (root) {
-                root->getAllObjects(results);
+        const Node* find(KeyView prefix) const {
+            const Node* current = root;
+            std::size_t steps = 0;
+            for (Key ch : prefix) {
+                ++steps;
+                current = current->children.find(ch);
+                if (!current) {
+                    break;
+                }
             }
-            return results;
+            events.lookup(steps);
+            return current;
+        }
+
+        /**
+         * @brief Non-const overload of find().
+         */
+        Node* find(KeyView prefix) {
+            return const_cast<Node*>(static_cast<const Trie*>(this)->find(prefix));
+        }
+
+        /**
+         * @brief Iterator over the children of one node, used by the explicit-stack walks.
+         */
+        using ChildIterator = typename Children::const_iterator;
+
+        /**
+         * @brief Collects all objects in the subtree rooted at @p node.
+         */
+        static void getAllObjects(const Node* node, std::vector<T*> &results) {
+            auto collect = [&results](T* obj) {
+                results.push_back(obj);
+                return true;
+            };
+            visitSubtree(node, collect);
+        }
+
+        /**
+         * @brief Applies a function to objects in the subtree until it asks to stop.
+         * @details Depth-first with an explicit stack, so deep keys cannot overflow the call
+         *          stack, and the callable is passed by reference rather than copied per level.
+         * @param function Called with each T* in lexicographic order; returns false to stop.
+         * @return False if the walk was stopped early.
+         */
+        template<typename Func>
+        static bool visitSubtree(const Node* node, Func& function) {
+            if (node->object && !function(node->object)) {
+                return false;
+            }
+            std::vector<std::pair<ChildIterator, ChildIterator>> stack;
+            stack.emplace_back(node->children.begin(), node->children.end());
+            while (!stack.empty()) {
+                auto& [next, last] = stack.back();
+                if (next == last) {
+                    stack.pop_back();
+                    continue;
+                }
+                const Node* child = (*next).second;
+                ++next;
+                if (child->object && !function(child->object)) {
+                    return false;
+                }
+                if (!child->children.empty()) {
+                    stack.emplace_back(child->children.begin(), child->children.end());
+                }
+            }
+            return true;
+        }
+
+        /**
+         * @brief visitSubtree() that also passes each object's key.
+         * @param key Holds the key of @p node on entry and on return. It is the only buffer
+         *        used: it grows and shrinks with the walk, so no key is allocated per node.
+         * @param function Called with `(KeyStringView key, T*)`; returns false to stop.
+         */
+        template<typename Func>
+        static bool visitSubtreeWithKeys(const Node* node, KeyString& key, Func& function) {
+            const std::size_t base = key.size();
+            if (node->object && !function(KeyStringView(key), node->object)) {
+                return false;
+            }
+            std::vector<std::pair<ChildIterator, ChildIterator>> stack;
+            stack.emplace_back(node->children.begin(), node->children.end());
+            while (!stack.empty()) {
+                auto& [next, last] = stack.back();
+                if (next == last) {
+                    stack.pop_back();
+                    continue;
+                }
+                auto [ch, child] = *next;
+                ++next;
+                key.resize(base + stack.size() - 1);
+                key.push_back(ch);
+                if (child->object && !function(KeyStringView(key), child->object)) {
+                    key.resize(base);
+                    return false;
+                }
+                if (!child->children.empty()) {
+                    stack.emplace_back(child->children.begin(), child->children.end());
+                }
+            }
+            key.resize(base);
+            return true;
+        }
+
+        /**
+         * @brief True if @p Func is a key-reconstructing callback `(KeyStringView key, T*)`.
+         */
+        template<typename Func>
+        static constexpr bool takesKey = std::is_invocable_v<Func&, KeyStringView, T*>;
+
+        /**
+         * @brief Walks the subtree at @p node with a user callback taking `T*` or
+         *        `(KeyStringView key, T*)`; see invokeVisitor() for the return value.
+         * @param key Key of @p node; only read for key-reconstructing callbacks.
+         * @return Number of objects passed to @p function.
+         */
+        template<typename Func>
+        static std::size_t visitWithCallback(const Node* node, KeyView key, Func& function) {
+            std::size_t visited = 0;
+            if constexpr (takesKey<Func>) {
+                KeyString buffer(key.begin(), key.end());
+                auto step = [&function, &visited](KeyStringView word, T* obj) {
+                    ++visited;
+                    return invokeVisitor(function, word, obj);
+                };
+                visitSubtreeWithKeys(node, buffer, step);
+            } else {
+                auto step = [&function, &visited](T* obj) {
+                    ++visited;
+                    return invokeVisitor(function, obj);
+                };
+                visitSubtree(node, step);
+            }
+            return visited;
+        }
+
+        /**
+         * @brief Adapts a user callback to the bool-returning form used by visitSubtree().
+         * @details Callbacks returning void never stop the walk.
+         */
+        template<typename Func, typename... Args>
+        static bool invokeVisitor(Func& function, Args&&... args) {
+            if constexpr (std::is_void_v<std::invoke_result_t<Func&, Args...>>) {
+                function(std::forward<Args>(args)...);
+                return true;
+            } else {
+                return static_cast<bool>(function(std::forward<Args>(args)...));
+            }
+        }
+
+        /**
+         * @brief One unit of a parallel walk: a whole subtree, or only the object at its root.
+         */
+        struct SubtreeTask {
+            const Node* node;
+            bool rootOnly;
+        };
+
+        /**
+         * @brief Splits the subtree at @p start into tasks whose outputs, concatenated in
+         *        order, equal visitSubtree(start).
+         * @details Expands the top levels breadth-first until there are at least @p target
+         *          tasks, the levels run out, or 8 levels were expanded.
+         */
+        static std::vector<SubtreeTask> splitSubtree(const Node* start, std::size_t target) {
+            std::vector<SubtreeTask> tasks{{start, false}};
+            std::vector<SubtreeTask> next;
+            for (int level = 0; level < 8 && tasks.size() < target; ++level) {
+                bool expanded = false;
+                next.clear();
+                for (const SubtreeTask& task : tasks) {
+                    if (task.rootOnly || task.node->children.empty()) {
+                        next.push_back(task);
+                        continue;
+                    }
+                    expanded = true;
+                    if (task.node->object) {
+                        next.push_back({task.node, true});
+                    }
+                    for (auto [key, child] : task.node->children) {
+                        next.push_back({child, false});
+                    }
+                }
+                tasks.swap(next);
+                if (!expanded) {
+                    break;
+                }
+            }
+            return tasks;
+        }
+
+        /**
+         * @brief Runs one task of splitSubtree() with a bool-returning visitor.
+         */
+        template<typename Func>
+        static void visitTask(const SubtreeTask& task, Func& function) {
+            if (task.rootOnly) {
+                function(task.node->object);
+            } else {
+                visitSubtree(task.node, function);
+            }
+        }
+
+        /**
+         * @brief Prunes the nodes at the end of `path` that hold no object and no children.
+         * @param word Word whose nodes `path` records, root first.
+         * @details Stops at the first node still in use; `path` keeps the surviving nodes.
+         */
+        void pruneEmptyTail(KeyView word) noexcept {
+            std::size_t depth = path.size() - 1;
+            while (depth > 0) {
+                Node* node = path[depth];
+                if (node->object || !node->children.empty()) {
+                    break;
+                }
+                path[depth - 1]->children.erase(word[depth - 1], storage.get());
+                destroyNode(node);
+                path.pop_back();
+                --depth;
+            }
+        }
+    public:
+        /**
+         * @class const_iterator
+         * @brief Input iterator over (key, object) pairs in lexicographic order.
+         *
+         * @details
+         * Walks the subtree with an explicit stack and rebuilds the key in a single buffer
+         * owned by the iterator. Dereferencing yields a `std::pair<std::string_view, T*>`
+         * (a BasicKeyView instead of the string_view for non-character keys);
+         * the key view stays valid until the iterator is advanced or destroyed. Because
+         * dereferenced pairs do not outlive the next increment, the iterator is tagged as an
+         * input iterator; copies walk independently, so multi-pass use over copies still works.
+         * An iterator can be kept between requests to resume a walk (pagination), as long as
+         * the Trie is not modified in the meantime.
+         */
+        class const_iterator {
+        public:
+            using value_type = std::pair<KeyStringView, T*>;
+            using reference = value_type;
+            using pointer = void;
+            using difference_type = std::ptrdiff_t;
+            using iterator_category = std::input_iterator_tag;
+
+            /**
+             * @brief Creates an end iterator.
+             */
+            const_iterator() = default;
+
+            value_type operator*() const {
+                return {KeyStringView(key.data(), key.size()), node->object};
+            }
+
+            const_iterator& operator++() {
+                advance();
+                return *this;
+            }
+
+            const_iterator operator++(int) {
+                const_iterator previous = *this;
+                advance();
+                return previous;
+            }
+
+            bool operator==(const const_iterator& other) const {
+                return node == other.node;
+            }
+
+            bool operator!=(const const_iterator& other) const {
+                return node != other.node;
+            }
+
+        private:
+            friend class Trie;
+
+            /**
+             * @brief Remaining children of each ancestor below the starting node.
+             */
+            struct Frame {
+                ChildIterator next;
+                ChildIterator last;
+            };
+
+            const Node* node = nullptr;
+            std::vector<Frame> stack;
+            KeyString key;
+
+            /**
+             * @brief Steps into the next child of the deepest unfinished ancestor.
+             * @details Called once the subtree of the current node is exhausted.
+             */
+            void leaveSubtree() {
+                while (!stack.empty()) {
+                    key.pop_back();
+                    Frame& frame = stack.back();
+                    if (frame.next != frame.last) {
+                        auto [ch, child] = *frame.next;
+                        ++frame.next;
+                        key.push_back(ch);
+                        node = child;
+                        return;
+                    }
+                    stack.pop_back();
+                }
+                node = nullptr;
+            }
+
+            /**
+             * @brief Moves to the next node holding an object, in pre-order.
+             */
+            void advance() {
+                do {
+                    if (!node->children.empty()) {
+                        ChildIterator first = node->children.begin();
+                        auto [ch, child] = *first;
+                        ++first;
+                        stack.push_back({first, node->children.end()});
+                        key.push_back(ch);
+                        node = child;
+                    } else {
+                        leaveSubtree();
+                    }
+                } while (node && !node->object);
+            }
+
+            /**
+             * @brief Settles on the current node if it holds an object, else moves forward.
+             */
+            void settle() {
+                if (node && !node->object) {
+                    advance();
+                }
+            }
+        };
+
+        /**
+         * @brief Iterator to the first word of the Trie.
+         */
+        const_iterator begin() const {
+            return begin(KeyView());
+        }
+
+        /**
+         * @brief Iterator to the first word starting with @p prefix.
+         * @details Incrementing it visits only words with that prefix, then reaches end().
+         */
+        const_iterator begin(KeyView prefix) const {
+            const_iterator it;
+            it.node = find(prefix);
+            it.key.assign(prefix.begin(), prefix.end());
+            it.settle();
+            return it;
+        }
+
+        /**
+         * @brief Past-the-end iterator.
+         */
+        const_iterator end() const {
+            return const_iterator();
+        }
+
+        /**
+         * @brief Iterator to the first word starting with @p prefix that sorts after @p cursor.
+         * @details Resumes a paginated walk from the last key returned, descending once along
+         *          @p cursor instead of rescanning the subtree from the prefix node.
+         * @param prefix Prefix restricting the walk.
+         * @param cursor Last key already seen.
+         */
+        const_iterator upperBound(KeyView prefix, KeyView cursor) const {
+            if (cursor.substr(0, prefix.size()) != prefix) {
+                bool before = std::lexicographical_compare(cursor.begin(), cursor.end(),
+                                                           prefix.begin(), prefix.end());
+                return before ? begin(prefix) : end();
+            }
+            const_iterator it;
+            it.node = find(prefix);
+            it.key.assign(prefix.begin(), prefix.end());
+            if (!it.node) {
+                return it;
+            }
+            for (std::size_t i = prefix.size(); i < cursor.size(); ++i) {
+                Key ch = cursor[i];
+                ChildIterator next = it.node->children.lowerBound(ch);
+                ChildIterator last = it.node->children.end();
+                if (next != last && (*next).first == ch) {
+                    const Node* child = (*next).second;
+                    it.stack.push_back({++next, last});
+                    it.key.push_back(ch);
+                    it.node = child;
+                    continue;
+                }
+                // The cursor leaves the tree here: continue with the next larger sibling
+                if (next == last) {
+                    it.leaveSubtree();
+                } else {
+                    auto [nextCh, child] = *next;
+                    it.stack.push_back({++next, last});
+                    it.key.push_back(nextCh);
+                    it.node = child;
+                }
+                it.settle();
+                return it;
+            }
+            it.advance();
+            return it;
+        }
+
+        /**
+         * @brief Default constructor. The Trie gets a storage of its own.
+         */
+        Trie() : Trie(std::make_shared<Storage>()) {}
+
+        /**
+         * @brief Creates a Trie that allocates its nodes from @p storage.
+         * @param storage Storage to draw nodes from. May be shared by several tries, in which
+         *                case nodes are freed individually instead of in bulk.
+         */
+        explicit Trie(std::shared_ptr<Storage> storage)
+            : storage(std::move(storage)), root(createNode()) {}
+
+        /**
+         * @brief Copy constructor is deleted to prevent shallow copies and double frees.
+         */
+        Trie(const Trie &) = delete;
+
+        /**
+         * @brief Copy assignment operator is deleted to prevent shallow copies.
+         */
+        Trie &operator=(const Trie&) = delete;
+
+        /**
+         * @brief Takes over the nodes, storage and counters of @p other in O(1).
+         * @details @p other is left without nodes or storage; it may only be destroyed,
+         *          assigned to, or revived with clear().
+         */
+        Trie(Trie&& other) noexcept
+            : storage(std::move(other.storage)),
+              events(other.events),
+              root(std::exchange(other.root, nullptr)),
+              path(std::move(other.path)),
+              index(std::move(other.index)) {
+            other.events = detail::CounterSet<recordsCounters>();
+        }
+
+        /**
+         * @brief Frees this Trie's nodes, then takes over those of @p other in O(1).
+         * @details Leaves @p other in the same state as the move constructor does.
+         */
+        Trie& operator=(Trie&& other) noexcept {
+            if (this != &other) {
+                if (root && !canReleaseInBulk()) {
+                    destroySubtree(root);
+                }
+                storage = std::move(other.storage);
+                root = std::exchange(other.root, nullptr);
+                path = std::move(other.path);
+                events = other.events;
+                other.events = detail::CounterSet<recordsCounters>();
+                index = std::move(other.index);
+            }
+            return *this;
+        }
+
+        /**
+         * @brief Destructor. Frees the memory allocated for nodes.
+         * @note This does NOT deallocate the `T* object` pointers (owned values are destroyed).
+         */
+        ~Trie() {
+            if (root && !canReleaseInBulk()) {
+                destroySubtree(root);
+            }
+            // Otherwise the storage frees every slab when the last reference goes away.
+        }
+
+        /**
+         * @brief Inserts a word with an associated object.
+         * @param object Pointer to associate with the word (not owned by Trie).
+         * @param word String to insert.
+         * @note Overwrites the object if the word already exists.
+         * @throws std::invalid_argument If @p word has an element the Children policy cannot
+         *         store (e.g. 2 in a BitTrieTraits Trie); the Trie is left unchanged.
+         */
+        void insert(T *object, KeyView word) {
+            static_assert(!ownsValues, "owning tries take values through emplace()/insertOrAssign()");
+            checkStorable(word);
+            if constexpr (countsWords || hashesWords) {
+                Node* current = findOrCreatePath(word);
+                std::ptrdiff_t delta = std::ptrdiff_t(object != nullptr) -
+                                       std::ptrdiff_t(current->object != nullptr);
+                if (delta > 0) {
+                    index.add(word, current);
+                } else if (delta < 0) {
+                    index.remove(word);
+                }
+                countWords(path.data(), path.size(), delta);
+                current->object = object;
+                return;
+            }
+            Node* current = root;
+            for (Key ch : word) {
+                Node* child = current->children.find(ch);
+                if (!child) {
+                    child = createNode();
+                    current->children.insert(ch, child, storage.get());
+                }
+                current = child;
+            }
+            current->object = object;
+        }
+
+        /**
+         * @brief Constructs a value for @p word in place unless the word already exists
+         *        (owning mode only).
+         * @param args Constructor arguments for T.
+         * @return The word's value and whether it was newly constructed.
+         * @throws std::invalid_argument As insert(), for elements the Children cannot store.
+         * @note Values never move: the pointer stays valid until the word is erased.
+         */
+        template<class... Args>
+        std::pair<T*, bool> emplace(KeyView word, Args&&... args) {
+            static_assert(ownsValues, "emplace() requires an owning Trie (see TrieMap)");
+            checkStorable(word);
+            Node* current = findOrCreatePath(word);
+            if (current->object) {
+                return {current->object, false};
+            }
+            bool indexed = false;
+            try {
+                index.add(word, current);
+                indexed = true;
+                current->object = ::new (current->valueSlot()) T(std::forward<Args>(args)...);
+            } catch (...) {
+                if (indexed) {
+                    index.remove(word);
+                }
+                pruneEmptyTail(word);
+                throw;
+            }
+            countWords(path.data(), path.size(), 1);
+            return {current->object, true};
+        }
+
+        /**
+         * @brief Stores @p value under @p word, assigning over an existing value
+         *        (owning mode only).
+         * @return Pointer to the stored value.
+         */
+        template<class V>
+        T* insertOrAssign(KeyView word, V&& value) {
+            auto [object, inserted] = emplace(word, std::forward<V>(value));
+            if (!inserted) {
+                *object = std::forward<V>(value);
+            }
+            return object;
         }
 
         /**
-         * @brief Deallocates all nodes. Does not deallocate associated objects.
+         * @brief Inserts a range of (word, object) pairs sorted by word.
+         * @details Each word resumes from the node of its longest common prefix with the
+         *          previous word instead of descending from the root again, so the whole range
+         *          is inserted in time linear in its total length. New nodes are created in key
+         *          order, which with PoolStorage also places each subtree contiguously.
+         * @tparam InputIt Iterator over pair-like elements: `first` is convertible to KeyView,
+         *         `second` to T* (or, in owning mode, a value assignable to T).
+         * @note Unsorted input still produces the right Trie, only without the speed-up.
+         *       A repeated word keeps its last object, as with repeated insert() calls.
+         * @throws std::invalid_argument As insert(); the words before the rejected one stay.
+         */
+        template<class InputIt>
+        void buildFromSorted(InputIt first, InputIt last) {
+            buildSorted(first, last, [](const InputIt& it) -> decltype(auto) { return *it; });
+        }
+
+        /**
+         * @brief Inserts a range of (word, object) pairs in any order.
+         * @details Sorts views of the words, then runs buildFromSorted(). A repeated word
+         *          keeps the object that comes last in the range.
+         * @throws std::invalid_argument As insert(), before anything is inserted.
+         * @tparam ForwardIt Iterator over pair-like elements that stay alive during the call.
+         */
+        template<class ForwardIt>
+        void buildFromUnsorted(ForwardIt first, ForwardIt last) {
+            std::vector<std::pair<KeyView, ForwardIt>> entries;
+            for (; first != last; ++first) {
+                entries.emplace_back(KeyView((*first).first), first);
+                checkStorable(entries.back().first);
+            }
+            std::stable_sort(entries.begin(), entries.end(), [](const auto& a, const auto& b) {
+                return std::lexicographical_compare(a.first.begin(), a.first.end(),
+                                                    b.first.begin(), b.first.end());
+            });
+            buildSorted(entries.begin(), entries.end(),
+                        [](auto it) -> decltype(auto) { return *it->second; });
+        }
+
+        /**
+         * @brief Inserts a range of (word, object) pairs in any order, building the subtrees
+         *        of different first key elements on several threads.
+         * @details Entries are bucketed by their first key element; each worker claims a
+         *          bucket, sorts it and builds each of its first-element subtrees detached from
+         *          the root, and the calling thread attaches them at the end. This only
+         *          scales when keys are spread over many first elements.
+         *          - A thread-safe storage (`threadSafe`, e.g. HeapStorage) is shared by all
+         *            workers.
+         *          - A storage with `adopt()` (PoolStorage) gives each worker its own arena,
+         *            adopted by the Trie's storage afterwards.
+         *          - Any other storage falls back to buildFromUnsorted().
+         *
+         *          Words whose first element already has a subtree, and the empty word, are
+         *          inserted on the calling thread. A repeated word keeps the object that comes
+         *          last in the range. If a worker throws, the subtrees built so far are
+         *          discarded and the exception is rethrown; the Trie keeps its old contents.
+         *          Words the Children cannot store are rejected up front, as in
+         *          buildFromUnsorted().
+         *          Sharding uses the value of the first element, so the key type must be an
+         *          integral or enumeration type (checked at compile time).
+         * @tparam ForwardIt Iterator over pair-like elements that stay alive during the call;
+         *         in owning mode the values are copied or moved by several threads at once.
+         * @param threadCount Number of threads including the caller; 0 uses
+         *        std::thread::hardware_concurrency().
+         */
+        template<class ForwardIt>
+        void buildParallel(ForwardIt first, ForwardIt last, std::size_t threadCount = 0) {
+            static_assert(std::is_integral_v<Key> || std::is_enum_v<Key>,
+                          "buildParallel() shards by key element value and needs integral keys");
+            constexpr bool sharedStorage = detail::IsThreadSafeStorage<Storage>::value;
+            constexpr bool arenaStorage = detail::CanAdoptStorage<Storage>::value;
+            std::size_t workers = threadCount ? threadCount : detail::defaultThreadCount();
+            if (!(sharedStorage || arenaStorage) || workers <= 1 || hashesWords) {
+                buildFromUnsorted(first, last);
+                return;
+            }
+
+            // Stable counting sort into buckets by first element; the empty word stays aside
+            constexpr std::size_t bucketCount = 256;
+            using Entry = std::pair<KeyView, ForwardIt>;
+            auto bucketOf = [](Key element) {
+                return static_cast<std::size_t>(static_cast<std::make_unsigned_t<Key>>(element)) %
+                       bucketCount;
+            };
+            std::vector<Entry> entries;
+            std::vector<std::size_t> offsets(bucketCount + 1, 0);
+            ForwardIt emptyWord = last;
+            for (; first != last; ++first) {
+                KeyView word((*first).first);
+                checkStorable(word);
+                if (word.empty()) {
+                    emptyWord = first;
+                    continue;
+                }
+                entries.emplace_back(word, first);
+                ++offsets[bucketOf(word[0]) + 1];
+            }
+            for (std::size_t bucket = 0; bucket < bucketCount; ++bucket) {
+                offsets[bucket + 1] += offsets[bucket];
+            }
+            std::vector<Entry> bucketed(entries.size());
+            {
+                std::vector<std::size_t> cursor(offsets.begin(), offsets.end() - 1);
+                for (Entry& entry : entries) {
+                    std::size_t bucket = bucketOf(entry.first[0]);
+                    bucketed[cursor[bucket]++] = std::move(entry);
+                }
+            }
+            entries.clear();
+            entries.shrink_to_fit();
+
+            struct Shard {
+                std::size_t created = 0;
+                std::vector<std::pair<Key, Node*>> subtrees;
+                std::vector<std::pair<std::size_t, std::size_t>> deferred;
+            };
+            std::vector<Shard> shards(bucketCount);
+            std::vector<std::unique_ptr<Storage>> arenas(workers);
+            auto entryOf = [](auto it) -> decltype(auto) { return *it->second; };
+            auto build = [&](std::size_t bucket, std::size_t worker) {
+                auto begin = bucketed.begin() + offsets[bucket];
+                auto end = bucketed.begin() + offsets[bucket + 1];
+                if (begin == end) {
+                    return;
+                }
+                std::stable_sort(begin, end, [](const Entry& a, const Entry& b) {
+                    return std::lexicographical_compare(a.first.begin(), a.first.end(),
+                                                        b.first.begin(), b.first.end());
+                });
+                Storage* from = storage.get();
+                if constexpr (!sharedStorage) {
+                    if (!arenas[worker]) {
+                        arenas[worker] = std::make_unique<Storage>();
+                    }
+                    from = arenas[worker].get();
+                }
+                std::vector<Node*> trail;
+                Shard& shard = shards[bucket];
+                while (begin != end) {
+                    Key element = begin->first[0];
+                    auto runEnd = std::find_if(begin, end, [element](const Entry& entry) {
+                        return entry.first[0] != element;
+                    });
+                    if (root->children.find(element)) {
+                        shard.deferred.emplace_back(begin - bucketed.begin(),
+                                                    runEnd - bucketed.begin());
+                    } else {
+                        Node* node = createNode(from);
+                        shard.subtrees.emplace_back(element, node);
+                        shard.created += 1 + buildSortedBelow(node, 1, begin, runEnd, entryOf,
+                                                              from, trail);
+                    }
+                    begin = runEnd;
+                }
+            };
+
+            try {
+                detail::parallelFor(bucketCount, workers, build);
+            } catch (...) {
+                adoptArenas(arenas);
+                for (Shard& shard : shards) {
+                    events.allocated(shard.created);
+                }
+                for (Shard& shard : shards) {
+                    for (auto& subtree : shard.subtrees) {
+                        destroySubtree(subtree.second);
+                    }
+                }
+                throw;
+            }
+            adoptArenas(arenas);
+
+            for (Shard& shard : shards) {
+                events.allocated(shard.created);
+                for (auto& subtree : shard.subtrees) {
+                    root->children.insert(subtree.first, subtree.second, storage.get());
+                    if constexpr (countsWords) {
+                        root->words += subtree.second->words;
+                    }
+                }
+            }
+            for (Shard& shard : shards) {
+                for (auto& range : shard.deferred) {
+                    buildSorted(bucketed.begin() + range.first, bucketed.begin() + range.second,
+                                entryOf);
+                }
+            }
+            if (emptyWord != last) {
+                const bool existed = root->object != nullptr;
+                assignValue(root, (*emptyWord).second);
+                std::ptrdiff_t delta =
+                    std::ptrdiff_t(root->object != nullptr) - std::ptrdiff_t(existed);
+                countWords(&root, 1, delta);
+            }
+        }
+
+        /**
+         * @brief Removes a word from the Trie.
+         * @param word Word to remove.
+         * @return True if word was found and removed, false if word doesn't exist.
+         * @note Does not deallocate the associated object; user must manage that (an owning
+         *       Trie destroys its value instead).
+         *       Automatically cleans up empty nodes after removal; with PoolStorage the
+         *       freed nodes are reused by later insertions.
+         */
+        bool erase(KeyView word) {
+            path.assign(1, root);
+            Node* current = root;
+            for (Key ch : word) {
+                current = current->children.find(ch);
+                if (!current) {
+                    return false;
+                }
+                path.push_back(current);
+            }
+            if (!current->object) {
+                return false;
+            }
+            countWords(path.data(), path.size(), -1);
+            index.remove(word);
+            destroyValue(current);
+            pruneEmptyTail(word);
+            return true;
+        }
+
+        /**
+         * @brief Removes every word of a range.
+         * @details Each word resumes from the deepest surviving node it shares with the
+         *          previous word, so a sorted range is erased in time linear in its total
+         *          length. Unsorted ranges are still erased correctly.
+         * @tparam InputIt Iterator over elements convertible to KeyView.
+         * @return Number of words found and removed.
+         */
+        template<class InputIt>
+        std::size_t eraseAll(InputIt first, InputIt last) {
+            std::size_t removed = 0;
+            KeyString previous;
+            path.assign(1, root);
+            for (; first != last; ++first) {
+                KeyView word(*first);
+                std::size_t common = 0;
+                std::size_t limit = std::min({previous.size(), word.size(), path.size() - 1});
+                while (common < limit && previous[common] == word[common]) {
+                    ++common;
+                }
+                path.resize(common + 1);
+                Node* current = path.back();
+                for (std::size_t i = common; current && i < word.size(); ++i) {
+                    current = current->children.find(word[i]);
+                    if (current) {
+                        path.push_back(current);
+                    }
+                }
+                previous.assign(word.begin(), word.end());
+                if (current && current->object) {
+                    countWords(path.data(), path.size(), -1);
+                    index.remove(word);
+                    destroyValue(current);
+                    pruneEmptyTail(word);
+                    ++removed;
+                }
+            }
+            return removed;
+        }
+
+        /**
+         * @brief Moves every word of @p other into this Trie and leaves @p other empty.
+         * @details When both tries allocate from the same storage object (see
+         *          Trie(std::shared_ptr<Storage>)), subtrees missing here are relinked instead
+         *          of copied, so the cost is proportional to the nodes both tries have in
+         *          common; tries with disjoint key ranges merge without allocating. With
+         *          different storages the nodes are copied and the values moved.
+         *          A word stored in both keeps this Trie's value, like std::map::merge; the
+         *          value of @p other is dropped.
+         *          With HashedTraits every word of @p other also costs an index move and one
+         *          lookup here.
+         *          If an allocation throws, both tries stay valid and every word is still in
+         *          one of them.
+         */
+        void merge(Trie&& other) {
+            if (this == &other || !other.root) {
+                return;
+            }
+            const bool splice = storage == other.storage;
+            index.reserve(other.index.size());
+            Node* freshRoot = other.createNode();
+
+            struct MergeStep {
+                Node* intoParent;
+                Node* from;
+                Key key;
+                std::size_t depth;
+            };
+            std::vector<MergeStep> pending;
+            // Expects `path`/`other.path` to end with into/from
+            auto enter = [&](Node* into, Node* from) {
+                if (from->object && !into->object) {
+                    if constexpr (ownsValues) {
+                        assignValue(into, std::move(*from->object));
+                    } else {
+                        assignValue(into, from->object);
+                    }
+                    countWords(path.data(), path.size(), 1);
+                    countWords(other.path.data(), other.path.size(), -1);
+                    other.destroyValue(from);
+                }
+                for (auto [key, child] : from->children) {
+                    pending.push_back({into, child, key, path.size()});
+                }
+            };
+
+            try {
+                path.assign(1, root);
+                other.path.assign(1, other.root);
+                enter(root, other.root);
+                while (!pending.empty()) {
+                    MergeStep step = pending.back();
+                    pending.pop_back();
+                    path.resize(step.depth);
+                    other.path.resize(step.depth);
+                    Node* into = step.intoParent->children.find(step.key);
+                    if (!into && splice) {
+                        step.intoParent->children.insert(step.key, step.from, storage.get());
+                        other.path.back()->children.erase(step.key, storage.get());
+                        std::ptrdiff_t words = wordsBelow(step.from);
+                        countWords(path.data(), path.size(), words);
+                        countWords(other.path.data(), other.path.size(), -words);
+                        continue;
+                    }
+                    if (!into) {
+                        into = createNode();
+                        try {
+                            step.intoParent->children.insert(step.key, into, storage.get());
+                        } catch (...) {
+                            destroyNode(into);
+                            throw;
+                        }
+                    }
+                    path.push_back(into);
+                    other.path.push_back(step.from);
+                    enter(into, step.from);
+                }
+            } catch (...) {
+                adoptIndexEntries(other);
+                other.destroyNode(freshRoot);
+                throw;
+            }
+            adoptIndexEntries(other);
+            // What is left of other holds no word that is not also stored here
+            other.index.clear();
+            other.destroySubtree(std::exchange(other.root, freshRoot));
+        }
+
+        /**
+         * @brief Detaches the words starting with @p prefix into a new Trie in O(m).
+         * @details The subtree is unlinked as a whole and hung below fresh copies of the m
+         *          prefix nodes, so the result keeps the full keys and no word is copied. The
+         *          result shares this Trie's storage. With HashedTraits the index entries of
+         *          the extracted words move as well, which takes a pass over the whole index.
+         * @return The extracted words; an empty Trie if no word starts with @p prefix.
+         */
+        Trie extractSubtree(KeyView prefix) {
+            Trie result(storage);
+            path.assign(1, root);
+            for (Key ch : prefix) {
+                Node* child = path.back()->children.find(ch);
+                if (!child) {
+                    return result;
+                }
+                path.push_back(child);
+            }
+            if (prefix.empty()) {
+                std::swap(root, result.root);
+                std::swap(index, result.index);
+                return result;
+            }
+
+            auto extracted = [prefix](const KeyString& key) {
+                return key.size() >= prefix.size() &&
+                       std::equal(prefix.begin(), prefix.end(), key.begin());
+            };
+            if constexpr (hashesWords) {
+                std::size_t moving = 0;
+                index.extractIf([&](KeyString& key, Node*) {
+                    moving += extracted(key);
+                    return false;
+                });
+                result.index.reserve(moving);
+            }
+
+            Node* node = path.back();
+            const Key last = prefix[prefix.size() - 1];
+            Node* parent = result.findOrCreatePath(prefix.substr(0, prefix.size() - 1));
+            parent->children.insert(last, node, storage.get());
+            std::ptrdiff_t words = wordsBelow(node);
+            countWords(result.path.data(), result.path.size(), words);
+
+            path.pop_back();
+            path.back()->children.erase(last, storage.get());
+            countWords(path.data(), path.size(), -words);
+            pruneEmptyTail(prefix);
+            index.extractIf([&](KeyString& key, Node* word) {
+                if (!extracted(key)) {
+                    return false;
+                }
+                result.index.add(std::move(key), word);
+                return true;
+            });
+            return result;
+        }
+
+        /**
+         * @brief Checks if a word exists and returns its associated object.
+         * @param word Word to search for.
+         * @return Object pointer if found, nullptr otherwise.
+         */
+        T* wordExists(KeyView word) {
+            return const_cast<T*>(static_cast<const Trie*>(this)->wordExists(word));
+        }
+
+        /**
+         * @brief Const overload of wordExists().
+         */
+        const T* wordExists(KeyView word) const {
+            if constexpr (hashesWords) {
+                events.lookup(0);
+                const Node* node = index.find(word);
+                return node ? node->object : nullptr;
+            }
+            const Node *current = find(word);
+            return current && current->object ? current->object : nullptr;
+        }
+
+        /**
+         * @brief Looks up many words at once, interleaving their walks to hide memory latency.
+         * @details Words are processed in groups; each round advances every unfinished lookup
+         *          of the group by one node and prefetches that node, so the cache misses of
+         *          independent lookups overlap instead of being paid one after another.
+         *          Only the node is prefetched: edges kept outside it (MapChildren tree nodes,
+         *          the arrays of SortedVectorChildren, DirectChildren and AdaptiveChildren)
+         *          are still loaded when the next step reads them.
+         * @tparam InputIt Iterator over elements convertible to KeyView. The viewed keys must
+         *         outlive the call (iterators yielding temporaries are not supported).
+         * @tparam OutputIt Output iterator accepting T*, one per word (nullptr if absent).
+         * @return Output iterator past the last written result.
+         */
+        template<class InputIt, class OutputIt>
+        OutputIt lookupBatch(InputIt first, InputIt last, OutputIt out) const {
+            struct Lookup {
+                KeyView word;
+                const Node* node;
+                std::size_t depth;
+            };
+            if constexpr (hashesWords) {
+                for (; first != last; ++first) {
+                    *out++ = const_cast<T*>(wordExists(KeyView(*first)));
+                }
+                return out;
+            }
+            constexpr std::size_t groupSize = 16;
+            Lookup group[groupSize];
+            while (first != last) {
+                std::size_t count = 0;
+                for (; count < groupSize && first != last; ++first, ++count) {
+                    group[count] = {KeyView(*first), root, 0};
+                }
+                bool pending = true;
+                while (pending) {
+                    pending = false;
+                    for (std::size_t i = 0; i < count; ++i) {
+                        Lookup& lookup = group[i];
+                        if (!lookup.node || lookup.depth == lookup.word.size()) {
+                            continue;
+                        }
+                        lookup.node = lookup.node->children.find(lookup.word[lookup.depth++]);
+                        if (lookup.node) {
+                            SEFN_PREFETCH(lookup.node);
+                            pending = pending || lookup.depth < lookup.word.size();
+                        }
+                    }
+                }
+                for (std::size_t i = 0; i < count; ++i) {
+                    events.lookup(group[i].depth);
+                    *out++ = group[i].node ? group[i].node->object : nullptr;
+                }
+            }
+            return out;
+        }
+
+        /**
+         * @brief Span form of lookupBatch(): writes `results[i]` for `words[i]`, i < count.
+         */
+        void lookupBatch(const KeyView* words, std::size_t count, T** results) const {
+            lookupBatch(words, words + count, results);
+        }
+
+        /**
+         * @brief Checks if a prefix exists.
+         * @param prefix Prefix to search for.
+         * @return True if any word starts with this prefix.
+         */
+        bool prefixExists(KeyView prefix) const {
+            return find(prefix) != nullptr;
+        }
+
+        /**
+         * @brief Number of words starting with @p prefix.
+         * @details O(m) with countsWords, otherwise a walk of the prefix subtree (still without
+         *          materializing it).
+         */
+        std::size_t countPrefix(KeyView prefix) const {
+            const Node* start = find(prefix);
+            if (!start) {
+                return 0;
+            }
+            if constexpr (countsWords) {
+                return start->words;
+            } else {
+                return forEachCompletion(prefix, [](T*) {});
+            }
+        }
+
+        /**
+         * @brief Number of words in the Trie; O(1) with countsWords, O(n) otherwise.
+         */
+        std::size_t size() const {
+            return countPrefix(KeyView());
+        }
+
+        /**
+         * @brief Number of stored words that sort before @p key (countsWords only).
+         * @details Descends along @p key, adding the counts of the siblings to the left of
+         *          each step: O(m * fanout). If @p key is stored, this is its zero-based
+         *          position in iteration order.
+         */
+        std::size_t rank(KeyView key) const {
+            static_assert(countsWords, "rank() requires subtree counts (see CountingTraits)");
+            std::size_t before = 0;
+            const Node* current = root;
+            for (Key ch : key) {
+                if (current->object) {
+                    ++before;  // A proper prefix of key sorts before it
+                }
+                ChildIterator stop = current->children.lowerBound(ch);
+                for (ChildIterator it = current->children.begin(); it != stop; ++it) {
+                    before += (*it).second->words;
+                }
+                current = current->children.find(ch);
+                if (!current) {
+                    break;
+                }
+            }
+            return before;
+        }
+
+        /**
+         * @brief Iterator to the word at zero-based position @p index in iteration order, or
+         *        end() if there are not that many words (countsWords only).
+         * @details Descends by subtree counts in O(depth * fanout); the iterator continues
+         *          over the rest of the Trie like one obtained from begin().
+         */
+        const_iterator select(std::size_t index) const {
+            static_assert(countsWords, "select() requires subtree counts (see CountingTraits)");
+            const_iterator it;
+            if (index >= root->words) {
+                return it;
+            }
+            const Node* current = root;
+            while (true) {
+                if (current->object) {
+                    if (index == 0) {
+                        break;
+                    }
+                    --index;
+                }
+                ChildIterator next = current->children.begin();
+                ChildIterator last = current->children.end();
+                const Node* child = nullptr;
+                for (; next != last; ++next) {
+                    child = (*next).second;
+                    if (index < child->words) {
+                        break;
+                    }
+                    index -= child->words;
+                }
+                it.key.push_back((*next).first);
+                ++next;
+                it.stack.push_back({next, last});
+                current = child;
+            }
+            it.node = current;
+            return it;
+        }
+
+        /**
+         * @brief Result of longestPrefixMatch(): the deepest stored word that prefixes a key.
+         */
+        struct PrefixMatch {
+            /**
+             * @brief Object of the matching word, or nullptr if no stored word prefixes the key.
+             */
+            T* object = nullptr;
+
+            /**
+             * @brief Length of the matching word (0 for no match or a match on the empty word).
+             */
+            std::size_t length = 0;
+        };
+
+        /**
+         * @brief Finds the longest stored word that is a prefix of @p key.
+         * @details One walk down the key, O(m). Typical for routing tables and ACLs.
+         */
+        PrefixMatch longestPrefixMatch(KeyView key) const {
+            PrefixMatch match;
+            const Node* current = root;
+            for (std::size_t depth = 0;; ++depth) {
+                if (current->object) {
+                    match = {current->object, depth};
+                }
+                if (depth == key.size() || !(current = current->children.find(key[depth]))) {
+                    return match;
+                }
+            }
+        }
+
+        /**
+         * @brief Longest prefix match for a range of keys.
+         * @details Each key resumes from the node path it shares with the previous key, so a
+         *          sorted batch walks every shared prefix once.
+         * @tparam InputIt Iterator over elements convertible to KeyView.
+         * @tparam OutputIt Output iterator accepting PrefixMatch, one per input key.
+         * @return Output iterator past the last written match.
+         */
+        template<class InputIt, class OutputIt>
+        OutputIt longestPrefixMatch(InputIt first, InputIt last, OutputIt out) const {
+            KeyString previous;
+            // nodes[d] matches the first d elements of the previous key; best[d] is the
+            // deepest word among nodes[0..d], as a depth, or none
+            constexpr std::size_t none = static_cast<std::size_t>(-1);
+            std::vector<const Node*> nodes{root};
+            std::vector<std::size_t> best{root->object ? 0 : none};
+            for (; first != last; ++first) {
+                KeyView key(*first);
+                std::size_t common = 0;
+                std::size_t limit = std::min({previous.size(), key.size(), nodes.size() - 1});
+                while (common < limit && previous[common] == key[common]) {
+                    ++common;
+                }
+                nodes.resize(common + 1);
+                best.resize(common + 1);
+                for (std::size_t depth = common; depth < key.size(); ++depth) {
+                    const Node* child = nodes.back()->children.find(key[depth]);
+                    if (!child) {
+                        break;
+                    }
+                    nodes.push_back(child);
+                    best.push_back(child->object ? depth + 1 : best.back());
+                }
+                previous.assign(key.begin(), key.end());
+                PrefixMatch match;
+                if (best.back() != none) {
+                    match = {nodes[best.back()]->object, best.back()};
+                }
+                *out++ = match;
+            }
+            return out;
+        }
+
+        /**
+         * @brief Visits every stored word that is a prefix of @p key, shortest first.
+         * @param function Called with `(KeyView word, T* object)`, where `word` is a slice of
+         *        @p key; may return bool, false stops the walk.
+         * @return Number of words passed to @p function.
+         */
+        template<typename Func>
+        std::size_t forEachPrefixOf(KeyView key, Func function) const {
+            std::size_t visited = 0;
+            const Node* current = root;
+            for (std::size_t depth = 0;; ++depth) {
+                if (current->object) {
+                    ++visited;
+                    if (!invokeVisitor(function, key.substr(0, depth), current->object)) {
+                        return visited;
+                    }
+                }
+                if (depth == key.size() || !(current = current->children.find(key[depth]))) {
+                    return visited;
+                }
+            }
+        }
+
+        /**
+         * @brief Applies a function to all objects in the Trie.
+         * @tparam Func Callable taking T*, or `(KeyStringView key, T*)` to also receive each
+         *         word; the key view is only valid during the call.
+         * @param function Called for each object in lexicographic order.
+         */
+        template<typename Func>
+        void traverse(Func function) const {
+            if constexpr (takesKey<Func>) {
+                auto step = [&function](KeyStringView key, T* obj) {
+                    function(key, obj);
+                };
+                visitWithCallback(root, KeyView(), step);
+            } else {
+                auto step = [&function](T* obj) {
+                    function(obj);
+                    return true;
+                };
+                visitSubtree(root, step);
+            }
+        }
+
+        /**
+         * @brief Retrieves all objects matching a prefix in lexicographic order.
+         * @param prefix String prefix to search for.
+         * @return Vector of pointers to matching objects, sorted lexicographically.
+         */
+        std::vector<T*> autoComplete(KeyView prefix) const {
+            std::vector<T*> results;
+            const Node* start = find(prefix);
+            if (start) {
+                getAllObjects(start, results);
+            }
+            return results;
+        }
+
+        /**
+         * @brief Retrieves at most @p limit objects matching a prefix in lexicographic order.
+         * @param prefix String prefix to search for.
+         * @param limit Maximum number of results. The walk stops as soon as it is reached.
+         * @return The first @p limit entries of autoComplete(prefix).
+         */
+        std::vector<T*> autoComplete(KeyView prefix, std::size_t limit) const {
+            std::vector<T*> results;
+            const Node* start = find(prefix);
+            if (start && limit > 0) {
+                auto collect = [&results, limit](T* obj) {
+                    results.push_back(obj);
+                    return results.size() < limit;
+                };
+                visitSubtree(start, collect);
+            }
+            return results;
+        }
+
+        /**
+         * @brief Calls a function for each object whose word starts with @p prefix.
+         * @tparam Func Callable taking T*, or `(KeyStringView key, T*)` to also receive the
+         *         whole word (built in one reusable buffer). It may return bool; returning
+         *         false stops the walk.
+         * @param prefix String prefix to search for.
+         * @param function Called in lexicographic order.
+         * @return Number of objects passed to @p function.
+         */
+        template<typename Func>
+        std::size_t forEachCompletion(KeyView prefix, Func function) const {
+            const Node* start = find(prefix);
+            return start ? visitWithCallback(start, prefix, function) : 0;
+        }
+
+        /**
+         * @brief Calls a function for each word matching a wildcard pattern.
+         * @details The walk is driven by the pattern: the trie keeps one state set of the
+         *          compiled pattern per depth, never enters a child that leaves the set empty,
+         *          and where a literal is the only thing the pattern can match next it looks
+         *          up that single child. Each node is visited at most once, so words are
+         *          reported once each, in lexicographic order.
+         *
+         *          Syntax: `?` matches one character, `*` any run (including none), `[abc]`,
+         *          `[a-z]` and `[!a-z]` / `[^a-z]` one character in or not in a set, and `\`
+         *          escapes the next character. A `[` without a closing `]` is a literal.
+         * @tparam Func Callable taking `(KeyStringView key, T*)` or T*. It may return bool;
+         *         returning false stops the walk.
+         * @return Number of words passed to @p function.
+         */
+        template<typename Func>
+        std::size_t forEachMatch(std::string_view pattern, Func function) const {
+            static_assert(std::is_same_v<Key, char>, "wildcard patterns need char keys");
+            const detail::WildcardPattern compiled(pattern);
+            const std::size_t width = compiled.size() + 1;
+            std::vector<unsigned char> rows(width);
+            compiled.start(rows.data());
+            KeyString key;
+            std::size_t visited = 0;
+            auto visit = [&](const Node* node, const unsigned char* states) {
+                if (!node->object || !states[width - 1]) {
+                    return true;
+                }
+                ++visited;
+                if constexpr (takesKey<Func>) {
+                    return invokeVisitor(function, KeyStringView(key), node->object);
+                } else {
+                    return invokeVisitor(function, node->object);
+                }
+            };
+            // Children worth trying from a node whose state set is @p states
+            auto candidates = [&compiled](const Node* node, const unsigned char* states) {
+                char literal;
+                if (!compiled.singleLiteral(states, literal)) {
+                    return std::make_pair(node->children.begin(), node->children.end());
+                }
+                ChildIterator first = node->children.lowerBound(literal);
+                ChildIterator last = first;
+                if (last != node->children.end() && (*last).first == literal) {
+                    ++last;
+                }
+                return std::make_pair(first, last);
+            };
+            if (!visit(root, rows.data())) {
+                return visited;
+            }
+
+            // stack.size() is the depth of the next child, whose row follows its parent's
+            std::vector<std::pair<ChildIterator, ChildIterator>> stack;
+            stack.push_back(candidates(root, rows.data()));
+            while (!stack.empty()) {
+                auto& [next, last] = stack.back();
+                if (next == last) {
+                    stack.pop_back();
+                    continue;
+                }
+                auto [ch, child] = *next;
+                ++next;
+                const std::size_t depth = stack.size();
+                rows.resize((depth + 1) * width);
+                const unsigned char* above = rows.data() + (depth - 1) * width;
+                unsigned char* states = rows.data() + depth * width;
+                if (!compiled.step(above, ch, states)) {
+                    continue;
+                }
+                key.resize(depth - 1);
+                key.push_back(ch);
+                if (!visit(child, states)) {
+                    return visited;
+                }
+                if (!child->children.empty()) {
+                    stack.push_back(candidates(child, states));
+                }
+            }
+            return visited;
+        }
+
+        /**
+         * @brief Retrieves the objects of all words matching a wildcard pattern.
+         * @param limit Maximum number of results; the walk stops once it is reached.
+         * @return Objects in lexicographic order of their words (syntax: see forEachMatch()).
+         */
+        std::vector<T*> matchPattern(
+            std::string_view pattern,
+            std::size_t limit = std::numeric_limits<std::size_t>::max()) const {
+            std::vector<T*> results;
+            if (limit == 0) {
+                return results;
+            }
+            auto collect = [&results, limit](T* obj) {
+                results.push_back(obj);
+                return results.size() < limit;
+            };
+            forEachMatch(pattern, collect);
+            return results;
+        }
+
+        /**
+         * @brief Result of fuzzySearch(): a stored word within the distance bound.
+         */
+        struct FuzzyMatch {
+            /**
+             * @brief Object of the matching word.
+             */
+            T* object = nullptr;
+
+            /**
+             * @brief Levenshtein distance between the word and the query.
+             */
+            std::size_t distance = 0;
+        };
+
+        /**
+         * @brief Visits every stored word within Levenshtein distance @p maxDistance of
+         *        @p query, in lexicographic order.
+         * @details Walks the Trie keeping one dynamic-programming row per depth, so each node
+         *          costs O(query length). A branch is abandoned as soon as every entry of its
+         *          row exceeds @p maxDistance, which confines the walk to nodes close to the
+         *          query.
+         * @param function Called with `(T* object, size_t distance)`; may return bool, false
+         *        stops the walk.
+         * @return Number of words passed to @p function.
+         */
+        template<typename Func>
+        std::size_t forEachFuzzyMatch(KeyView query, std::size_t maxDistance,
+                                      Func function) const {
+            const std::size_t width = query.size() + 1;
+            std::vector<std::size_t> rows(width);
+            for (std::size_t i = 0; i < width; ++i) {
+                rows[i] = i;
+            }
+            std::size_t visited = 0;
+            auto visit = [&](const Node* node, std::size_t distance) {
+                if (!node->object || distance > maxDistance) {
+                    return true;
+                }
+                ++visited;
+                return invokeVisitor(function, node->object, distance);
+            };
+            if (!visit(root, query.size())) {
+                return visited;
+            }
+
+            // stack.size() is the depth of the next child, whose row follows its parent's
+            std::vector<std::pair<ChildIterator, ChildIterator>> stack;
+            stack.emplace_back(root->children.begin(), root->children.end());
+            while (!stack.empty()) {
+                auto& [next, last] = stack.back();
+                if (next == last) {
+                    stack.pop_back();
+                    continue;
+                }
+                auto [key, child] = *next;
+                ++next;
+                const std::size_t depth = stack.size();
+                rows.resize((depth + 1) * width);
+                const std::size_t* above = rows.data() + (depth - 1) * width;
+                std::size_t* row = rows.data() + depth * width;
+                row[0] = depth;
+                std::size_t best = row[0];
+                for (std::size_t i = 1; i < width; ++i) {
+                    std::size_t substitution = above[i - 1] + (query[i - 1] == key ? 0 : 1);
+                    row[i] = std::min({above[i] + 1, row[i - 1] + 1, substitution});
+                    best = std::min(best, row[i]);
+                }
+                if (best > maxDistance) {
+                    continue;
+                }
+                if (!visit(child, row[width - 1])) {
+                    return visited;
+                }
+                if (!child->children.empty()) {
+                    stack.emplace_back(child->children.begin(), child->children.end());
+                }
+            }
+            return visited;
+        }
+
+        /**
+         * @brief Finds stored words within Levenshtein distance @p maxDistance of @p query.
+         * @param limit Maximum number of results; the walk stops once it is reached.
+         * @return Matches in lexicographic order of their words (see forEachFuzzyMatch()).
+         */
+        std::vector<FuzzyMatch> fuzzySearch(
+            KeyView query, std::size_t maxDistance,
+            std::size_t limit = std::numeric_limits<std::size_t>::max()) const {
+            std::vector<FuzzyMatch> results;
+            if (limit == 0) {
+                return results;
+            }
+            auto collect = [&results, limit](T* object, std::size_t distance) {
+                results.push_back({object, distance});
+                return results.size() < limit;
+            };
+            forEachFuzzyMatch(query, maxDistance, collect);
+            return results;
+        }
+
+        /**
+         * @brief Applies a function to all objects in the Trie from several threads.
+         * @details The top levels are split into about 8 tasks per thread, which the threads
+         *          claim as they finish the previous one. The Trie must not be modified during
+         *          the call. Exceptions thrown by @p function are rethrown on the calling
+         *          thread after all workers have stopped.
+         * @tparam Func Callable taking T*. It is shared by all threads, so it must be safe to
+         *         call concurrently.
+         * @param function Called once per object, in no particular order.
+         * @param threadCount Number of threads including the caller; 0 uses
+         *        std::thread::hardware_concurrency().
+         */
+        template<typename Func>
+        void traverseParallel(Func function, std::size_t threadCount = 0) const {
+            std::size_t workers = threadCount ? threadCount : detail::defaultThreadCount();
+            std::vector<SubtreeTask> tasks = splitSubtree(root, workers * 8);
+            auto run = [&](std::size_t index, std::size_t) {
+                auto step = [&function](T* obj) {
+                    function(obj);
+                    return true;
+                };
+                visitTask(tasks[index], step);
+            };
+            detail::parallelFor(tasks.size(), workers, run);
+        }
+
+        /**
+         * @brief Retrieves all objects matching a prefix, walking the subtree from several
+         *        threads.
+         * @details Worth it for prefixes with large subtrees; small ones are dominated by
+         *          thread start-up. The Trie must not be modified during the call.
+         * @param prefix String prefix to search for.
+         * @param order Lexicographic returns exactly autoComplete(prefix) by joining per-task
+         *        buffers in key order; Unordered fills one buffer per thread instead.
+         * @param threadCount Number of threads including the caller; 0 uses
+         *        std::thread::hardware_concurrency().
+         */
+        std::vector<T*> autoCompleteParallel(KeyView prefix,
+                                             ParallelOrder order = ParallelOrder::Lexicographic,
+                                             std::size_t threadCount = 0) const {
+            std::vector<T*> results;
+            const Node* start = find(prefix);
+            if (!start) {
+                return results;
+            }
+            std::size_t workers = threadCount ? threadCount : detail::defaultThreadCount();
+            std::vector<SubtreeTask> tasks = splitSubtree(start, workers * 8);
+            const bool ordered = order == ParallelOrder::Lexicographic;
+            std::vector<std::vector<T*>> buffers(ordered ? tasks.size() : workers);
+            auto run = [&](std::size_t index, std::size_t worker) {
+                std::vector<T*>& buffer = buffers[ordered ? index : worker];
+                auto collect = [&buffer](T* obj) {
+                    buffer.push_back(obj);
+                    return true;
+                };
+                visitTask(tasks[index], collect);
+            };
+            detail::parallelFor(tasks.size(), workers, run);
+
+            std::size_t total = 0;
+            for (const std::vector<T*>& buffer : buffers) {
+                total += buffer.size();
+            }
+            results.reserve(total);
+            for (const std::vector<T*>& buffer : buffers) {
+                results.insert(results.end(), buffer.begin(), buffer.end());
+            }
+            return results;
+        }
+
+        /**
+         * @brief Measures the subtree of @p prefix (the whole Trie by default).
+         * @details One walk over the subtree; meant for capacity planning and for spotting
+         *          bloated prefixes, not for hot paths. Depths are relative to the prefix.
+         * @return Empty statistics if no word starts with @p prefix.
+         */
+        TrieStats stats(KeyView prefix = KeyView()) const {
+            TrieStats result;
+            const Node* start = find(prefix);
+            if (!start) {
+                return result;
+            }
+            auto bump = [](std::vector<std::size_t>& histogram, std::size_t index) {
+                if (histogram.size() <= index) {
+                    histogram.resize(index + 1);
+                }
+                ++histogram[index];
+            };
+            struct Pending {
+                const Node* node;
+                std::size_t depth;
+                std::size_t chain;  // Length of the single-child run ending at the parent
+            };
+            std::vector<Pending> pending{{start, 0, 0}};
+            while (!pending.empty()) {
+                Pending entry = pending.back();
+                pending.pop_back();
+                const Node* node = entry.node;
+                const std::size_t fanout = node->children.size();
+                ++result.nodes;
+                result.words += node->object != nullptr;
+                result.edgeBytes += node->children.memoryBytes();
+                bump(result.fanout, fanout);
+                bump(result.depth, entry.depth);
+                const bool linksChain = fanout == 1 && !node->object;
+                if (!linksChain && entry.chain > 0) {
+                    bump(result.chains, entry.chain);
+                }
+                for (auto [key, child] : node->children) {
+                    pending.push_back({child, entry.depth + 1, linksChain ? entry.chain + 1 : 0});
+                }
+            }
+            result.nodeBytes = result.nodes * sizeof(Node);
+            result.valueBytes = result.nodes * sizeof(T*);
+            if constexpr (ownsValues) {
+                result.valueBytes += result.nodes * sizeof(T);
+            }
+            if (prefix.empty()) {
+                result.indexBytes = index.memoryBytes();
+            }
+            return result;
+        }
+
+        /**
+         * @brief Hot-path counters since construction or the last resetCounters()
+         *        (recordsCounters only).
+         */
+        const TrieCounters& counters() const {
+            static_assert(recordsCounters, "counters() requires InstrumentedTraits");
+            return events.values;
+        }
+
+        /**
+         * @brief Zeroes the hot-path counters (recordsCounters only).
+         */
+        void resetCounters() {
+            static_assert(recordsCounters, "resetCounters() requires InstrumentedTraits");
+            events.values = TrieCounters();
+        }
+
+        /**
+         * @brief Deallocates all nodes. Does not deallocate associated objects (owned values
+         *        are destroyed).
+         * @details Runs in O(slabs) when the Trie is the sole user of a PoolStorage.
          */
         void clear() {
-            for (auto &[ch, child] : children) {
-                delete child;
-                child = nullptr;
+            if (!storage) {
+                storage = std::make_shared<Storage>();  // moved-from Trie
+            } else if (canReleaseInBulk()) {
+                storage->release();
+            } else {
+                destroySubtree(root);
             }
-            children.clear();
+            index.clear();
+            root = createNode();
+        }
+
+        /**
+         * @brief Returns the storage nodes are allocated from.
+         */
+        const std::shared_ptr<Storage>& getStorage() const {
+            return storage;
         }
     };
+    /**
+     * @brief A Trie that owns its values, stored inline in the nodes.
+     *
+     * @details Words get values through emplace() and insertOrAssign(), lookups return
+     * pointers into the nodes (no separate allocation, no extra indirection), and erase(),
+     * clear() and destruction run the value destructors.
+     *
+     * @example
+     * ```cpp
+     * Sefn::TrieMap<int> counts;
+     * counts.emplace("apple", 1);
+     * ++*counts.wordExists("apple");
+     * counts.insertOrAssign("pear", 7);
+     * ```
+     */
+    template<class T, class Traits = TrieTraits>
+    using TrieMap = Trie<T, OwningTraits<Traits>>;
+
 } // namespace Sefn
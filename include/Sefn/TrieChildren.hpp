@@ -0,0 +1,803 @@
+#pragma once
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <limits>
+#include <map>
+#include <type_traits>
+#include <utility>
+#include "NodeStorage.hpp"
+#include "detail/Simd.hpp"
+
+/**
+ * @file Sefn/TrieChildren.hpp
+ * @brief Child-container policies selecting how a Trie node stores its outgoing edges.
+ *
+ * Every policy is a tag struct exposing `template<class Key, class Node, class Storage>
+ * class Container`. All containers iterate their edges in ascending `std::less<Key>` order,
+ * which is what gives traverse() and autoComplete() their lexicographic output.
+ *
+ * Container interface (used by the Trie, not meant to be called directly):
+ * - `explicit Container(Storage*)`
+ * - `Node* find(Key) const` - child for a key, or nullptr
+ * - `void insert(Key, Node*, Storage*)` - adds an edge; the key must not be present
+ * - `void erase(Key, Storage*)` - removes an existing edge
+ * - `std::size_t size() const`, `bool empty() const`
+ * - `std::size_t memoryBytes() const` - bytes held outside the node (only needed by stats())
+ * - `begin()`, `end()`, `lowerBound(Key)` - ordered iteration over `std::pair<Key, Node*>`
+ * - `void release(Storage*)` - returns out-of-line memory before the owning node dies
+ * - `static bool accepts(Key)` - optional; false for keys the container cannot store, which
+ *   the Trie then rejects before creating any node
+ */
+
+namespace Sefn {
+
+    namespace detail {
+
+        /**
+         * @brief Maps an 8-bit key to a table index that preserves `std::less<Key>` order.
+         */
+        template<class Key>
+        constexpr std::size_t byteIndex(Key key) {
+            static_assert(sizeof(Key) == 1, "direct tables require 8-bit keys");
+            return static_cast<std::size_t>(
+                static_cast<int>(key) - static_cast<int>(std::numeric_limits<Key>::min()));
+        }
+
+        /**
+         * @brief Inverse of byteIndex().
+         */
+        template<class Key>
+        constexpr Key byteKey(std::size_t index) {
+            return static_cast<Key>(static_cast<int>(index) +
+                                    static_cast<int>(std::numeric_limits<Key>::min()));
+        }
+
+        /**
+         * @brief Position of @p key in a sorted key array, or the insertion point.
+         * @details Linear scan for short arrays, binary search beyond that.
+         */
+        template<class Key>
+        std::size_t sortedPosition(const Key* keys, std::size_t count, Key key) {
+            if (count <= 16) {
+                std::size_t i = 0;
+                while (i < count && keys[i] < key) {
+                    ++i;
+                }
+                return i;
+            }
+            return static_cast<std::size_t>(std::lower_bound(keys, keys + count, key) - keys);
+        }
+
+        /**
+         * @brief Position of @p key in a sorted key array, or @p count if it is missing.
+         * @details 8-bit keys use the vector byte search of Simd.hpp; it ignores the order
+         *          and scans all keys at once, which beats a binary search at trie fan-outs.
+         */
+        template<class Key>
+        std::size_t findPosition(const Key* keys, std::size_t count, Key key) {
+            if constexpr (sizeof(Key) == 1 && std::is_integral_v<Key>) {
+                return findByte(reinterpret_cast<const unsigned char*>(keys), count,
+                                static_cast<unsigned char>(key));
+            } else {
+                std::size_t i = sortedPosition(keys, count, key);
+                return i < count && keys[i] == key ? i : count;
+            }
+        }
+
+        /**
+         * @brief Forward iterator shared by the array-based containers.
+         * @details Walks positions `[0, limit)` of a container, skipping empty ones. The
+         *          container provides `edgeAt(position)` returning a pair with a null node
+         *          for unused positions.
+         */
+        template<class Container, class Key, class Node>
+        class PositionIterator {
+        public:
+            using value_type = std::pair<Key, Node*>;
+            using reference = value_type;
+            using difference_type = std::ptrdiff_t;
+            using iterator_category = std::forward_iterator_tag;
+
+            PositionIterator() = default;
+
+            PositionIterator(const Container* container, std::size_t position)
+                : container(container), position(position) {
+                skipEmpty();
+            }
+
+            value_type operator*() const {
+                return container->edgeAt(position);
+            }
+
+            PositionIterator& operator++() {
+                ++position;
+                skipEmpty();
+                return *this;
+            }
+
+            PositionIterator operator++(int) {
+                PositionIterator previous = *this;
+                ++*this;
+                return previous;
+            }
+
+            bool operator==(const PositionIterator& other) const {
+                return position == other.position;
+            }
+
+            bool operator!=(const PositionIterator& other) const {
+                return position != other.position;
+            }
+
+        private:
+            const Container* container = nullptr;
+            std::size_t position = 0;
+
+            void skipEmpty() {
+                std::size_t limit = container->positionLimit();
+                while (position < limit && !container->edgeAt(position).second) {
+                    ++position;
+                }
+                if (position > limit) {
+                    position = limit;
+                }
+            }
+        };
+
+        template<class Container, class Key, class = void>
+        struct HasKeyFilter : std::false_type {};
+
+        /**
+         * @brief True if @p Container has the optional `static bool accepts(Key)` hook.
+         */
+        template<class Container, class Key>
+        struct HasKeyFilter<Container, Key,
+                            std::void_t<decltype(Container::accepts(std::declval<Key>()))>>
+            : std::true_type {};
+
+    } // namespace detail
+
+    /**
+     * @struct MapChildren
+     * @brief Children stored in a `std::map`. Flexible, but every edge is its own tree node.
+     */
+    struct MapChildren {
+        template<class Key, class Node, class Storage>
+        class Container {
+        private:
+            using Map = std::map<Key, Node*, std::less<Key>,
+                                 StorageAllocator<std::pair<const Key, Node*>, Storage>>;
+            Map map;
+
+        public:
+            class const_iterator {
+            public:
+                using value_type = std::pair<Key, Node*>;
+                using reference = value_type;
+                using difference_type = std::ptrdiff_t;
+                using iterator_category = std::forward_iterator_tag;
+
+                const_iterator() = default;
+                explicit const_iterator(typename Map::const_iterator it) : it(it) {}
+
+                value_type operator*() const { return {it->first, it->second}; }
+                const_iterator& operator++() { ++it; return *this; }
+                const_iterator operator++(int) { const_iterator previous = *this; ++it; return previous; }
+                bool operator==(const const_iterator& other) const { return it == other.it; }
+                bool operator!=(const const_iterator& other) const { return it != other.it; }
+
+            private:
+                typename Map::const_iterator it;
+            };
+
+            explicit Container(Storage* storage)
+                : map(typename Map::allocator_type(storage)) {}
+
+            Node* find(Key key) const {
+                auto it = map.find(key);
+                return it == map.end() ? nullptr : it->second;
+            }
+
+            void insert(Key key, Node* child, Storage*) {
+                map.emplace(key, child);
+            }
+
+            void erase(Key key, Storage*) {
+                map.erase(key);
+            }
+
+            std::size_t size() const { return map.size(); }
+            bool empty() const { return map.empty(); }
+
+            /**
+             * @brief Estimated heap bytes of the map nodes: the edge plus three links and the
+             *        color word of a typical red-black tree node.
+             */
+            std::size_t memoryBytes() const {
+                return map.size() * (sizeof(typename Map::value_type) + 4 * sizeof(void*));
+            }
+
+            const_iterator begin() const { return const_iterator(map.begin()); }
+            const_iterator end() const { return const_iterator(map.end()); }
+            const_iterator lowerBound(Key key) const { return const_iterator(map.lower_bound(key)); }
+
+            void release(Storage*) noexcept {}
+        };
+    };
+
+    /**
+     * @struct SortedVectorChildren
+     * @brief Children stored in parallel sorted key/pointer arrays.
+     *
+     * @details Best for low fan-out nodes. A node with a single child keeps it inline;
+     * larger sets live in one block from the node storage, grown and shrunk by doubling.
+     */
+    struct SortedVectorChildren {
+        template<class Key, class Node, class Storage>
+        class Container {
+        private:
+            union {
+                Node* single;
+                Node** nodes;
+            };
+            Key singleKey{};
+            std::uint32_t count = 0;
+            std::uint32_t capacity = 1;
+
+            bool isInline() const { return capacity <= 1; }
+            Node* const* nodeData() const { return isInline() ? &single : nodes; }
+            Node** nodeData() { return isInline() ? &single : nodes; }
+            const Key* keyData() const {
+                return isInline() ? &singleKey : reinterpret_cast<const Key*>(nodes + capacity);
+            }
+            Key* keyData() {
+                return isInline() ? &singleKey : reinterpret_cast<Key*>(nodes + capacity);
+            }
+
+            static std::size_t blockBytes(std::size_t capacity) {
+                return capacity * (sizeof(Node*) + sizeof(Key));
+            }
+
+            void reallocate(std::uint32_t newCapacity, Storage* storage) {
+                Node** newNodes = nullptr;
+                if (newCapacity > 1) {
+                    newNodes = static_cast<Node**>(
+                        storage->allocate(blockBytes(newCapacity), alignof(Node*)));
+                    std::memcpy(newNodes, nodeData(), count * sizeof(Node*));
+                    std::memcpy(reinterpret_cast<Key*>(newNodes + newCapacity), keyData(),
+                                count * sizeof(Key));
+                }
+                Node* keepNode = count ? nodeData()[0] : nullptr;
+                Key keepKey = count ? keyData()[0] : Key{};
+                if (!isInline()) {
+                    storage->deallocate(nodes, blockBytes(capacity), alignof(Node*));
+                }
+                capacity = newCapacity;
+                if (isInline()) {
+                    single = keepNode;
+                    singleKey = keepKey;
+                } else {
+                    nodes = newNodes;
+                }
+            }
+
+        public:
+            using const_iterator = detail::PositionIterator<Container, Key, Node>;
+            friend const_iterator;
+
+            explicit Container(Storage*) : single(nullptr) {}
+
+            Node* find(Key key) const {
+                std::size_t i = detail::findPosition(keyData(), count, key);
+                return i < count ? nodeData()[i] : nullptr;
+            }
+
+            void insert(Key key, Node* child, Storage* storage) {
+                if (count == capacity) {
+                    reallocate(capacity * 2, storage);
+                }
+                Key* keys = keyData();
+                Node** children = nodeData();
+                std::size_t i = detail::sortedPosition(keys, count, key);
+                std::memmove(keys + i + 1, keys + i, (count - i) * sizeof(Key));
+                std::memmove(children + i + 1, children + i, (count - i) * sizeof(Node*));
+                keys[i] = key;
+                children[i] = child;
+                ++count;
+            }
+
+            void erase(Key key, Storage* storage) {
+                Key* keys = keyData();
+                Node** children = nodeData();
+                std::size_t i = detail::sortedPosition(keys, count, key);
+                if (i == count || keys[i] != key) {
+                    return;
+                }
+                std::memmove(keys + i, keys + i + 1, (count - i - 1) * sizeof(Key));
+                std::memmove(children + i, children + i + 1, (count - i - 1) * sizeof(Node*));
+                --count;
+                if (count <= 1 && !isInline()) {
+                    reallocate(1, storage);
+                } else if (count > 0 && count * 4 <= capacity) {
+                    reallocate(capacity / 2, storage);
+                }
+            }
+
+            std::size_t size() const { return count; }
+            bool empty() const { return count == 0; }
+            std::size_t memoryBytes() const { return isInline() ? 0 : blockBytes(capacity); }
+
+            const_iterator begin() const { return const_iterator(this, 0); }
+            const_iterator end() const { return const_iterator(this, count); }
+            const_iterator lowerBound(Key key) const {
+                return const_iterator(this, detail::sortedPosition(keyData(), count, key));
+            }
+
+            void release(Storage* storage) noexcept {
+                if (!isInline()) {
+                    storage->deallocate(nodes, blockBytes(capacity), alignof(Node*));
+                }
+                count = 0;
+                capacity = 1;
+                single = nullptr;
+            }
+
+        private:
+            std::size_t positionLimit() const { return count; }
+            std::pair<Key, Node*> edgeAt(std::size_t position) const {
+                return {keyData()[position], nodeData()[position]};
+            }
+        };
+    };
+
+    /**
+     * @struct DirectChildren
+     * @brief Children stored in a 256-entry table indexed by the key byte.
+     *
+     * @details One array access per lookup, for dense nodes. The table is allocated from the
+     * node storage on the first insertion and freed when the last child is removed.
+     * Requires an 8-bit key type.
+     */
+    struct DirectChildren {
+        template<class Key, class Node, class Storage>
+        class Container {
+        private:
+            static constexpr std::size_t tableSize = 256;
+            Node** table = nullptr;
+            std::uint32_t count = 0;
+
+        public:
+            using const_iterator = detail::PositionIterator<Container, Key, Node>;
+            friend const_iterator;
+
+            explicit Container(Storage*) {}
+
+            Node* find(Key key) const {
+                return table ? table[detail::byteIndex(key)] : nullptr;
+            }
+
+            void insert(Key key, Node* child, Storage* storage) {
+                if (!table) {
+                    table = static_cast<Node**>(
+                        storage->allocate(tableSize * sizeof(Node*), alignof(Node*)));
+                    std::fill(table, table + tableSize, nullptr);
+                }
+                table[detail::byteIndex(key)] = child;
+                ++count;
+            }
+
+            void erase(Key key, Storage* storage) {
+                if (!table || !table[detail::byteIndex(key)]) {
+                    return;
+                }
+                table[detail::byteIndex(key)] = nullptr;
+                if (--count == 0) {
+                    release(storage);
+                }
+            }
+
+            std::size_t size() const { return count; }
+            bool empty() const { return count == 0; }
+            std::size_t memoryBytes() const { return table ? tableSize * sizeof(Node*) : 0; }
+
+            const_iterator begin() const { return const_iterator(this, 0); }
+            const_iterator end() const { return const_iterator(this, positionLimit()); }
+            const_iterator lowerBound(Key key) const {
+                return const_iterator(this, table ? detail::byteIndex(key) : 0);
+            }
+
+            void release(Storage* storage) noexcept {
+                if (table) {
+                    storage->deallocate(table, tableSize * sizeof(Node*), alignof(Node*));
+                    table = nullptr;
+                }
+                count = 0;
+            }
+
+        private:
+            std::size_t positionLimit() const { return table ? tableSize : 0; }
+            std::pair<Key, Node*> edgeAt(std::size_t position) const {
+                return {detail::byteKey<Key>(position), table[position]};
+            }
+        };
+    };
+
+    /**
+     * @struct AdaptiveChildren
+     * @brief Children layout that changes with fan-out, modeled on ART's Node4/16/48/256.
+     *
+     * @details
+     * - Up to 4 and up to 16 children: sorted key/pointer arrays.
+     * - Up to 48 children: a 256-byte index into 48 pointer slots.
+     * - More: a direct 256-entry pointer table.
+     *
+     * Nodes grow to the next layout when full and shrink back (with some hysteresis)
+     * as children are removed. Requires an 8-bit key type.
+     */
+    struct AdaptiveChildren {
+        template<class Key, class Node, class Storage>
+        class Container {
+        private:
+            enum Kind : std::uint8_t { Empty, Sorted4, Sorted16, Indexed48, Direct256 };
+
+            static constexpr std::size_t tableSize = 256;
+            static constexpr std::uint8_t noSlot = 0xFF;
+
+            void* block = nullptr;
+            std::uint16_t count = 0;
+            Kind kind = Empty;
+
+            static std::size_t capacityOf(Kind kind) {
+                switch (kind) {
+                    case Sorted4: return 4;
+                    case Sorted16: return 16;
+                    case Indexed48: return 48;
+                    case Direct256: return 256;
+                    default: return 0;
+                }
+            }
+
+            static std::size_t blockBytes(Kind kind) {
+                switch (kind) {
+                    case Sorted4:
+                    case Sorted16: return capacityOf(kind) * (sizeof(Node*) + sizeof(Key));
+                    case Indexed48: return 48 * sizeof(Node*) + tableSize;
+                    case Direct256: return tableSize * sizeof(Node*);
+                    default: return 0;
+                }
+            }
+
+            // Sorted layouts: Node* nodes[capacity] followed by Key keys[capacity].
+            Node** sortedNodes() const { return static_cast<Node**>(block); }
+            Key* sortedKeys() const {
+                return reinterpret_cast<Key*>(sortedNodes() + capacityOf(kind));
+            }
+
+            // Indexed48 layout: Node* slots[48] followed by uint8 index[256].
+            Node** slots() const { return static_cast<Node**>(block); }
+            std::uint8_t* slotIndex() const {
+                return reinterpret_cast<std::uint8_t*>(slots() + 48);
+            }
+
+            // Direct256 layout: Node* table[256].
+            Node** table() const { return static_cast<Node**>(block); }
+
+            void convert(Kind target, Storage* storage) {
+                void* oldBlock = block;
+                Kind oldKind = kind;
+                // Collect the current edges in order before switching layouts
+                Key keys[tableSize];
+                Node* children[tableSize];
+                std::size_t n = 0;
+                for (auto [key, child] : *this) {
+                    keys[n] = key;
+                    children[n] = child;
+                    ++n;
+                }
+
+                block = target == Empty ? nullptr
+                                        : storage->allocate(blockBytes(target), alignof(Node*));
+                kind = target;
+                switch (target) {
+                    case Sorted4:
+                    case Sorted16:
+                        std::memcpy(sortedNodes(), children, n * sizeof(Node*));
+                        std::memcpy(sortedKeys(), keys, n * sizeof(Key));
+                        break;
+                    case Indexed48:
+                        std::fill(slots(), slots() + 48, nullptr);
+                        std::fill(slotIndex(), slotIndex() + tableSize, noSlot);
+                        for (std::size_t i = 0; i < n; ++i) {
+                            slots()[i] = children[i];
+                            slotIndex()[detail::byteIndex(keys[i])] = static_cast<std::uint8_t>(i);
+                        }
+                        break;
+                    case Direct256:
+                        std::fill(table(), table() + tableSize, nullptr);
+                        for (std::size_t i = 0; i < n; ++i) {
+                            table()[detail::byteIndex(keys[i])] = children[i];
+                        }
+                        break;
+                    default:
+                        break;
+                }
+                if (oldKind != Empty) {
+                    storage->deallocate(oldBlock, blockBytes(oldKind), alignof(Node*));
+                }
+            }
+
+        public:
+            using const_iterator = detail::PositionIterator<Container, Key, Node>;
+            friend const_iterator;
+
+            explicit Container(Storage*) {
+                static_assert(sizeof(Key) == 1, "AdaptiveChildren requires 8-bit keys");
+            }
+
+            Node* find(Key key) const {
+                switch (kind) {
+                    case Sorted4: {
+                        const Key* keys = sortedKeys();
+                        for (std::size_t i = 0; i < count; ++i) {
+                            if (keys[i] == key) {
+                                return sortedNodes()[i];
+                            }
+                        }
+                        return nullptr;
+                    }
+                    case Sorted16: {
+                        // The key array always has room for 16, so one vector compare covers it
+                        std::size_t i = detail::findByteIn16(
+                            reinterpret_cast<const unsigned char*>(sortedKeys()), count,
+                            static_cast<unsigned char>(key));
+                        return i < count ? sortedNodes()[i] : nullptr;
+                    }
+                    case Indexed48: {
+                        std::uint8_t slot = slotIndex()[detail::byteIndex(key)];
+                        return slot == noSlot ? nullptr : slots()[slot];
+                    }
+                    case Direct256:
+                        return table()[detail::byteIndex(key)];
+                    default:
+                        return nullptr;
+                }
+            }
+
+            void insert(Key key, Node* child, Storage* storage) {
+                if (count == capacityOf(kind)) {
+                    convert(kind == Empty ? Sorted4 : static_cast<Kind>(kind + 1), storage);
+                }
+                switch (kind) {
+                    case Sorted4:
+                    case Sorted16: {
+                        Key* keys = sortedKeys();
+                        Node** children = sortedNodes();
+                        std::size_t i = detail::sortedPosition(keys, count, key);
+                        std::memmove(keys + i + 1, keys + i, (count - i) * sizeof(Key));
+                        std::memmove(children + i + 1, children + i, (count - i) * sizeof(Node*));
+                        keys[i] = key;
+                        children[i] = child;
+                        break;
+                    }
+                    case Indexed48: {
+                        std::uint8_t slot = 0;
+                        while (slots()[slot]) {
+                            ++slot;
+                        }
+                        slots()[slot] = child;
+                        slotIndex()[detail::byteIndex(key)] = slot;
+                        break;
+                    }
+                    case Direct256:
+                        table()[detail::byteIndex(key)] = child;
+                        break;
+                    default:
+                        break;
+                }
+                ++count;
+            }
+
+            void erase(Key key, Storage* storage) {
+                switch (kind) {
+                    case Sorted4:
+                    case Sorted16: {
+                        Key* keys = sortedKeys();
+                        Node** children = sortedNodes();
+                        std::size_t i = detail::sortedPosition(keys, count, key);
+                        if (i == count || keys[i] != key) {
+                            return;
+                        }
+                        std::memmove(keys + i, keys + i + 1, (count - i - 1) * sizeof(Key));
+                        std::memmove(children + i, children + i + 1,
+                                     (count - i - 1) * sizeof(Node*));
+                        break;
+                    }
+                    case Indexed48: {
+                        std::uint8_t& slot = slotIndex()[detail::byteIndex(key)];
+                        if (slot == noSlot) {
+                            return;
+                        }
+                        slots()[slot] = nullptr;
+                        slot = noSlot;
+                        break;
+                    }
+                    case Direct256: {
+                        Node*& entry = table()[detail::byteIndex(key)];
+                        if (!entry) {
+                            return;
+                        }
+                        entry = nullptr;
+                        break;
+                    }
+                    default:
+                        return;
+                }
+                --count;
+                // Shrink with hysteresis so alternating insert/erase does not thrash
+                if (count == 0) {
+                    convert(Empty, storage);
+                } else if (kind == Direct256 && count < 40) {
+                    convert(Indexed48, storage);
+                } else if (kind == Indexed48 && count < 12) {
+                    convert(Sorted16, storage);
+                } else if (kind == Sorted16 && count < 3) {
+                    convert(Sorted4, storage);
+                }
+            }
+
+            std::size_t size() const { return count; }
+            bool empty() const { return count == 0; }
+            std::size_t memoryBytes() const { return blockBytes(kind); }
+
+            const_iterator begin() const { return const_iterator(this, 0); }
+            const_iterator end() const { return const_iterator(this, positionLimit()); }
+            const_iterator lowerBound(Key key) const {
+                if (kind == Sorted4 || kind == Sorted16) {
+                    return const_iterator(this, detail::sortedPosition(sortedKeys(), count, key));
+                }
+                return const_iterator(this, kind == Empty ? 0 : detail::byteIndex(key));
+            }
+
+            void release(Storage* storage) noexcept {
+                if (kind != Empty) {
+                    storage->deallocate(block, blockBytes(kind), alignof(Node*));
+                }
+                block = nullptr;
+                kind = Empty;
+                count = 0;
+            }
+
+        private:
+            std::size_t positionLimit() const {
+                switch (kind) {
+                    case Sorted4:
+                    case Sorted16: return count;
+                    case Indexed48:
+                    case Direct256: return tableSize;
+                    default: return 0;
+                }
+            }
+
+            std::pair<Key, Node*> edgeAt(std::size_t position) const {
+                switch (kind) {
+                    case Sorted4:
+                    case Sorted16:
+                        return {sortedKeys()[position], sortedNodes()[position]};
+                    case Indexed48: {
+                        std::uint8_t slot = slotIndex()[position];
+                        return {detail::byteKey<Key>(position),
+                                slot == noSlot ? nullptr : slots()[slot]};
+                    }
+                    case Direct256:
+                        return {detail::byteKey<Key>(position), table()[position]};
+                    default:
+                        return {Key{}, nullptr};
+                }
+            }
+        };
+    };
+
+    /**
+     * @struct FixedArrayChildren
+     * @brief Children stored in an inline array of @p N slots indexed by the key value.
+     *
+     * @details For small alphabets: `FixedArrayChildren<2>` for bit keys, `<16>` for nibbles,
+     * `<256>` for bytes. A lookup is a single indexed load with no search and no indirection,
+     * at the cost of N pointers in every node. With N = 256 any 8-bit key type is accepted
+     * and ordered as std::less does. Otherwise stored keys must lie in `[0, N)`: accepts()
+     * tells the Trie to reject other keys, and lookups and erasures of them find nothing.
+     */
+    template<std::size_t N>
+    struct FixedArrayChildren {
+        static_assert(N >= 1 && N <= 256, "FixedArrayChildren supports 1 to 256 slots");
+
+        template<class Key, class Node, class Storage>
+        class Container {
+        private:
+            Node* slots[N] = {};
+            std::uint16_t count = 0;
+
+            static std::size_t slotOf(Key key) {
+                if constexpr (N == 256 && sizeof(Key) == 1) {
+                    return detail::byteIndex(key);
+                } else {
+                    return static_cast<std::size_t>(key);
+                }
+            }
+
+            static bool isNegative(Key key) {
+                if constexpr (std::is_signed_v<Key> && !(N == 256 && sizeof(Key) == 1)) {
+                    return key < Key(0);
+                } else {
+                    return false;
+                }
+            }
+
+            /**
+             * @brief True if @p key has a slot (negative keys wrap to huge slots, so they fail).
+             */
+            static bool hasSlot(Key key) {
+                return slotOf(key) < N;
+            }
+
+            static Key keyOf(std::size_t slot) {
+                if constexpr (N == 256 && sizeof(Key) == 1) {
+                    return detail::byteKey<Key>(slot);
+                } else {
+                    return static_cast<Key>(slot);
+                }
+            }
+
+        public:
+            using const_iterator = detail::PositionIterator<Container, Key, Node>;
+            friend const_iterator;
+
+            explicit Container(Storage*) {}
+
+            static bool accepts(Key key) {
+                return hasSlot(key);
+            }
+
+            Node* find(Key key) const {
+                return hasSlot(key) ? slots[slotOf(key)] : nullptr;
+            }
+
+            void insert(Key key, Node* child, Storage*) {
+                assert(hasSlot(key) && "FixedArrayChildren<N>: key element outside [0, N)");
+                slots[slotOf(key)] = child;
+                ++count;
+            }
+
+            void erase(Key key, Storage*) {
+                if (hasSlot(key) && slots[slotOf(key)]) {
+                    slots[slotOf(key)] = nullptr;
+                    --count;
+                }
+            }
+
+            std::size_t size() const { return count; }
+            bool empty() const { return count == 0; }
+            std::size_t memoryBytes() const { return 0; }
+
+            const_iterator begin() const { return const_iterator(this, 0); }
+            const_iterator end() const { return const_iterator(this, N); }
+            const_iterator lowerBound(Key key) const {
+                return const_iterator(this, isNegative(key) ? 0 : std::min(slotOf(key), N));
+            }
+
+            void release(Storage*) noexcept {}
+
+        private:
+            std::size_t positionLimit() const { return N; }
+            std::pair<Key, Node*> edgeAt(std::size_t position) const {
+                return {keyOf(position), slots[position]};
+            }
+        };
+    };
+
+} // namespace Sefn
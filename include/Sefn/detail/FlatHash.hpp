@@ -0,0 +1,267 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include "../KeyView.hpp"
+
+/**
+ * @file Sefn/detail/FlatHash.hpp
+ * @brief Open-addressing hash index from whole keys to pointers, used by hashed tries.
+ */
+
+namespace Sefn {
+
+    namespace detail {
+
+        /**
+         * @class FlatHashIndex
+         * @brief Maps keys to `Mapped*` in one flat array of slots with linear probing.
+         *
+         * @details Each slot keeps the full hash, the pointer and a copy of the key, so a hit
+         * costs one hash of the query plus (usually) one key comparison. Removed slots become
+         * tombstones that later insertions reuse; the table is rebuilt when live slots and
+         * tombstones together pass 3/4 of the capacity.
+         *
+         * reserve(n) guarantees that the next n insertions of moved-in keys do not allocate,
+         * which lets callers update the index from code paths that must not throw.
+         *
+         * @tparam Key Key element type (character or integral).
+         */
+        template<class Key, class Mapped>
+        class FlatHashIndex {
+        public:
+            using KeyView = BasicKeyView<Key>;
+            using Owned = KeyString<Key>;
+
+            FlatHashIndex() = default;
+
+            FlatHashIndex(FlatHashIndex&& other) noexcept
+                : slots(std::move(other.slots)),
+                  count(std::exchange(other.count, 0)),
+                  removed(std::exchange(other.removed, 0)) {}
+
+            FlatHashIndex& operator=(FlatHashIndex&& other) noexcept {
+                slots = std::move(other.slots);
+                count = std::exchange(other.count, 0);
+                removed = std::exchange(other.removed, 0);
+                return *this;
+            }
+
+            /**
+             * @brief Pointer stored for @p key, or nullptr.
+             */
+            Mapped* find(KeyView key) const noexcept {
+                if (count == 0) {
+                    return nullptr;
+                }
+                std::size_t hash = hashOf(key);
+                for (std::size_t i = hash & mask();; i = (i + 1) & mask()) {
+                    const Slot& slot = slots[i];
+                    if (slot.state == State::Empty) {
+                        return nullptr;
+                    }
+                    if (slot.state == State::Live && slot.hash == hash && equal(slot.key, key)) {
+                        return slot.value;
+                    }
+                }
+            }
+
+            /**
+             * @brief Adds @p key, which must not be present. Copies the key.
+             */
+            void add(KeyView key, Mapped* value) {
+                add(Owned(key.begin(), key.end()), value);
+            }
+
+            /**
+             * @brief Adds @p key, which must not be present. Does not allocate if room was
+             *        reserved.
+             */
+            void add(Owned&& key, Mapped* value) {
+                reserve(1);
+                std::size_t hash = hashOf(KeyView(key));
+                std::size_t i = hash & mask();
+                while (slots[i].state == State::Live) {
+                    i = (i + 1) & mask();
+                }
+                Slot& slot = slots[i];
+                if (slot.state == State::Removed) {
+                    --removed;
+                }
+                slot.key = std::move(key);
+                slot.value = value;
+                slot.hash = hash;
+                slot.state = State::Live;
+                ++count;
+            }
+
+            /**
+             * @brief Removes @p key.
+             * @return False if it was not present.
+             */
+            bool remove(KeyView key) noexcept {
+                if (count == 0) {
+                    return false;
+                }
+                std::size_t hash = hashOf(key);
+                for (std::size_t i = hash & mask();; i = (i + 1) & mask()) {
+                    Slot& slot = slots[i];
+                    if (slot.state == State::Empty) {
+                        return false;
+                    }
+                    if (slot.state == State::Live && slot.hash == hash && equal(slot.key, key)) {
+                        bury(slot);
+                        return true;
+                    }
+                }
+            }
+
+            /**
+             * @brief Calls `take(Owned& key, Mapped* value)` for every entry and removes the
+             *        entries for which it returns true. @p take may move from `key`.
+             */
+            template<class Func>
+            void extractIf(Func take) noexcept {
+                for (Slot& slot : slots) {
+                    if (slot.state == State::Live && take(slot.key, slot.value)) {
+                        bury(slot);
+                    }
+                }
+            }
+
+            /**
+             * @brief Makes room for @p extra more entries without rebuilding the table.
+             */
+            void reserve(std::size_t extra) {
+                if ((count + removed + extra) * 4 > slots.size() * 3) {
+                    rebuild(count + extra);
+                }
+            }
+
+            /**
+             * @brief Removes every entry and frees the table.
+             */
+            void clear() noexcept {
+                slots = std::vector<Slot>();
+                count = 0;
+                removed = 0;
+            }
+
+            std::size_t size() const {
+                return count;
+            }
+
+            /**
+             * @brief Bytes of the slot array plus the key elements (small-key buffers are
+             *        counted twice, so this slightly overestimates).
+             */
+            std::size_t memoryBytes() const {
+                std::size_t bytes = slots.capacity() * sizeof(Slot);
+                for (const Slot& slot : slots) {
+                    bytes += slot.key.size() * sizeof(Key);
+                }
+                return bytes;
+            }
+
+        private:
+            enum class State : std::uint8_t { Empty, Live, Removed };
+
+            struct Slot {
+                std::size_t hash = 0;
+                Mapped* value = nullptr;
+                Owned key;
+                State state = State::Empty;
+            };
+
+            std::vector<Slot> slots;
+            std::size_t count = 0;
+            std::size_t removed = 0;
+
+            std::size_t mask() const {
+                return slots.size() - 1;
+            }
+
+            static bool equal(const Owned& stored, KeyView key) {
+                return stored.size() == key.size() &&
+                       std::equal(stored.begin(), stored.end(), key.begin());
+            }
+
+            static std::size_t hashOf(KeyView key) {
+                if constexpr (std::is_same_v<Key, char>) {
+                    return std::hash<std::string_view>()(std::string_view(key));
+                } else {
+                    static_assert(std::is_integral_v<Key>, "hashed tries need integral keys");
+                    std::uint64_t hash = 14695981039346656037ull;  // FNV-1a
+                    for (Key element : key) {
+                        hash = (hash ^ static_cast<std::uint64_t>(element)) * 1099511628211ull;
+                    }
+                    hash ^= hash >> 33;  // Spread the mixed bits into the low (mask) bits
+                    hash *= 0xff51afd7ed558ccdull;
+                    hash ^= hash >> 33;
+                    return static_cast<std::size_t>(hash);
+                }
+            }
+
+            void bury(Slot& slot) noexcept {
+                slot.key = Owned();
+                slot.value = nullptr;
+                slot.state = State::Removed;
+                --count;
+                ++removed;
+            }
+
+            /**
+             * @brief Moves the live entries into a table sized for @p entries.
+             */
+            void rebuild(std::size_t entries) {
+                std::size_t capacity = 8;
+                while (entries * 4 > capacity * 3) {
+                    capacity *= 2;
+                }
+                std::vector<Slot> fresh(capacity);
+                for (Slot& slot : slots) {
+                    if (slot.state != State::Live) {
+                        continue;
+                    }
+                    std::size_t i = slot.hash & (capacity - 1);
+                    while (fresh[i].state == State::Live) {
+                        i = (i + 1) & (capacity - 1);
+                    }
+                    fresh[i] = std::move(slot);
+                }
+                slots = std::move(fresh);
+                removed = 0;
+            }
+        };
+
+        /**
+         * @brief Exact-match index of a Trie: a FlatHashIndex from words to their nodes,
+         *        or (for @p enabled false) an empty stand-in whose updates compile to nothing.
+         */
+        template<bool enabled, class Key, class Node>
+        struct WordIndex {
+            using Owned = KeyString<Key>;
+
+            Node* find(BasicKeyView<Key>) const noexcept { return nullptr; }
+            void add(BasicKeyView<Key>, Node*) const noexcept {}
+            bool remove(BasicKeyView<Key>) const noexcept { return false; }
+            template<class Func>
+            void extractIf(Func) const noexcept {}
+            void reserve(std::size_t) const noexcept {}
+            void clear() const noexcept {}
+            std::size_t size() const { return 0; }
+            std::size_t memoryBytes() const { return 0; }
+        };
+
+        template<class Key, class Node>
+        struct WordIndex<true, Key, Node> : FlatHashIndex<Key, Node> {};
+
+    } // namespace detail
+
+} // namespace Sefn
@@ -0,0 +1,98 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <exception>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/**
+ * @file Sefn/detail/Parallel.hpp
+ * @brief Minimal fork-join helper shared by the parallel Trie operations.
+ */
+
+namespace Sefn {
+
+    /**
+     * @brief Result order of parallel collection operations.
+     */
+    enum class ParallelOrder {
+        /**
+         * @brief Same order as the sequential operation (per-task buffers joined in order).
+         */
+        Lexicographic,
+
+        /**
+         * @brief Any order; each worker fills one buffer, which avoids per-task buffers.
+         */
+        Unordered
+    };
+
+    namespace detail {
+
+        /**
+         * @brief Worker count used when the caller passes 0.
+         */
+        inline std::size_t defaultThreadCount() {
+            unsigned int count = std::thread::hardware_concurrency();
+            return count ? count : 1;
+        }
+
+        /**
+         * @brief Runs `task(index, worker)` for every index in `[0, count)` on up to
+         *        @p workers threads (the calling thread included).
+         * @details Workers claim the next index from a shared counter, so uneven tasks balance
+         *          themselves. The first exception thrown by a task is rethrown after all
+         *          workers have joined; remaining tasks are skipped. If a thread cannot be
+         *          started, the tasks are shared by the workers already running.
+         */
+        template<class Func>
+        void parallelFor(std::size_t count, std::size_t workers, Func& task) {
+            workers = std::min(workers, count);
+            if (workers <= 1) {
+                for (std::size_t index = 0; index < count; ++index) {
+                    task(index, std::size_t(0));
+                }
+                return;
+            }
+
+            std::atomic<std::size_t> next{0};
+            std::exception_ptr failure;
+            std::mutex failureMutex;
+            auto run = [&](std::size_t worker) {
+                try {
+                    for (std::size_t index = next++; index < count; index = next++) {
+                        task(index, worker);
+                    }
+                } catch (...) {
+                    next = count;
+                    std::lock_guard<std::mutex> lock(failureMutex);
+                    if (!failure) {
+                        failure = std::current_exception();
+                    }
+                }
+            };
+
+            std::vector<std::thread> threads;
+            threads.reserve(workers - 1);
+            for (std::size_t worker = 1; worker < workers; ++worker) {
+                try {
+                    threads.emplace_back(run, worker);
+                } catch (...) {
+                    break;  // Out of threads: the running workers claim the tasks left
+                }
+            }
+            run(0);
+            for (std::thread& thread : threads) {
+                thread.join();
+            }
+            if (failure) {
+                std::rethrow_exception(failure);
+            }
+        }
+
+    } // namespace detail
+
+} // namespace Sefn
@@ -0,0 +1,26 @@
+#pragma once
+
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+#include <xmmintrin.h>
+#endif
+
+/**
+ * @file Sefn/detail/Prefetch.hpp
+ * @brief Portable read-prefetch hint.
+ */
+
+/**
+ * @def SEFN_PREFETCH(address)
+ * @brief Hints the CPU to start loading the cache line at @p address for reading.
+ * @details Expands to nothing on compilers without a prefetch intrinsic. Define
+ *          SEFN_NO_PREFETCH to disable the hint everywhere (e.g. to measure its effect).
+ */
+#if defined(SEFN_NO_PREFETCH)
+#define SEFN_PREFETCH(address) ((void)(address))
+#elif defined(__GNUC__) || defined(__clang__)
+#define SEFN_PREFETCH(address) __builtin_prefetch((address), 0, 3)
+#elif defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+#define SEFN_PREFETCH(address) _mm_prefetch(reinterpret_cast<const char*>(address), _MM_HINT_T0)
+#else
+#define SEFN_PREFETCH(address) ((void)(address))
+#endif
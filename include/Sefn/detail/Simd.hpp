@@ -0,0 +1,203 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * @file Sefn/detail/Simd.hpp
+ * @brief Byte search and common-prefix kernels for child lookup and edge comparison.
+ *
+ * The instruction set is picked at compile time from the target flags: AVX2 (`-mavx2`),
+ * SSE2 (always on x86-64) or NEON (AArch64/ARMv7 with NEON), with a scalar fallback.
+ * Define SEFN_NO_SIMD to force the scalar code (e.g. to measure the kernels' effect).
+ *
+ * The kernels never read outside `[data, data + count)`: the last partial vector is handled
+ * by an overlapping load that ends at the last element, or by scalar code for short inputs.
+ */
+
+#if !defined(SEFN_NO_SIMD) && (defined(__SSE2__) || defined(_M_X64) || \
+                               (defined(_M_IX86_FP) && _M_IX86_FP >= 2))
+#define SEFN_SIMD_SSE2 1
+#include <emmintrin.h>
+#if defined(__AVX2__)
+#define SEFN_SIMD_AVX2 1
+#include <immintrin.h>
+#endif
+#elif !defined(SEFN_NO_SIMD) && (defined(__ARM_NEON) || defined(__ARM_NEON__))
+#define SEFN_SIMD_NEON 1
+#include <arm_neon.h>
+#endif
+
+#if defined(_MSC_VER) && !defined(__clang__)
+#include <intrin.h>
+#endif
+
+namespace Sefn {
+
+    namespace detail {
+
+        /**
+         * @brief Index of the lowest set bit of a non-zero mask.
+         */
+        inline unsigned lowestBit(std::uint64_t mask) noexcept {
+#if defined(_MSC_VER) && !defined(__clang__)
+            unsigned long index = 0;
+#if defined(_M_X64) || defined(_M_ARM64)
+            _BitScanForward64(&index, mask);
+#else
+            if (!_BitScanForward(&index, static_cast<unsigned long>(mask))) {
+                _BitScanForward(&index, static_cast<unsigned long>(mask >> 32));
+                index += 32;
+            }
+#endif
+            return static_cast<unsigned>(index);
+#else
+            return static_cast<unsigned>(__builtin_ctzll(mask));
+#endif
+        }
+
+#if defined(SEFN_SIMD_SSE2)
+        /**
+         * @brief Bit i set where byte i of the 16 bytes at @p a equals byte i at @p b
+         *        (or the broadcast @p b).
+         */
+        inline unsigned equalMask16(const unsigned char* a, __m128i b) noexcept {
+            __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(a));
+            return static_cast<unsigned>(_mm_movemask_epi8(_mm_cmpeq_epi8(block, b)));
+        }
+#elif defined(SEFN_SIMD_NEON)
+        /**
+         * @brief Four bits per byte, set where the 16 bytes compared equal (NEON has no
+         *        movemask; narrowing the comparison result is the usual substitute).
+         */
+        inline std::uint64_t equalNibbles16(uint8x16_t a, uint8x16_t b) noexcept {
+            uint8x16_t equal = vceqq_u8(a, b);
+            uint8x8_t narrowed = vshrn_n_u16(vreinterpretq_u16_u8(equal), 4);
+            return vget_lane_u64(vreinterpret_u64_u8(narrowed), 0);
+        }
+#endif
+
+        /**
+         * @brief Position of the first @p byte in `bytes[0, count)`, or @p count.
+         */
+        inline std::size_t findByte(const unsigned char* bytes, std::size_t count,
+                                    unsigned char byte) noexcept {
+#if defined(SEFN_SIMD_AVX2)
+            if (count >= 32) {
+                const __m256i needle = _mm256_set1_epi8(static_cast<char>(byte));
+                for (std::size_t i = 0;; i += 32) {
+                    // The last block overlaps the previous one; its early bytes held no match
+                    std::size_t at = i + 32 <= count ? i : count - 32;
+                    __m256i block =
+                        _mm256_loadu_si256(reinterpret_cast<const __m256i*>(bytes + at));
+                    unsigned mask = static_cast<unsigned>(
+                        _mm256_movemask_epi8(_mm256_cmpeq_epi8(block, needle)));
+                    if (mask) {
+                        return at + lowestBit(mask);
+                    }
+                    if (at + 32 >= count) {
+                        return count;
+                    }
+                }
+            }
+#endif
+#if defined(SEFN_SIMD_SSE2)
+            if (count >= 16) {
+                const __m128i needle = _mm_set1_epi8(static_cast<char>(byte));
+                for (std::size_t i = 0;; i += 16) {
+                    std::size_t at = i + 16 <= count ? i : count - 16;
+                    unsigned mask = equalMask16(bytes + at, needle);
+                    if (mask) {
+                        return at + lowestBit(mask);
+                    }
+                    if (at + 16 >= count) {
+                        return count;
+                    }
+                }
+            }
+#elif defined(SEFN_SIMD_NEON)
+            if (count >= 16) {
+                const uint8x16_t needle = vdupq_n_u8(byte);
+                for (std::size_t i = 0;; i += 16) {
+                    std::size_t at = i + 16 <= count ? i : count - 16;
+                    std::uint64_t mask = equalNibbles16(vld1q_u8(bytes + at), needle);
+                    if (mask) {
+                        return at + lowestBit(mask) / 4;
+                    }
+                    if (at + 16 >= count) {
+                        return count;
+                    }
+                }
+            }
+#endif
+            for (std::size_t i = 0; i < count; ++i) {
+                if (bytes[i] == byte) {
+                    return i;
+                }
+            }
+            return count;
+        }
+
+        /**
+         * @brief findByte() for an array with room for 16 bytes of which the first
+         *        @p count (at most 16) are in use: one vector compare, no loop.
+         */
+        inline std::size_t findByteIn16(const unsigned char* bytes, std::size_t count,
+                                        unsigned char byte) noexcept {
+#if defined(SEFN_SIMD_SSE2)
+            unsigned mask = equalMask16(bytes, _mm_set1_epi8(static_cast<char>(byte))) &
+                            ((1u << count) - 1);
+            return mask ? lowestBit(mask) : count;
+#elif defined(SEFN_SIMD_NEON)
+            std::uint64_t mask = equalNibbles16(vld1q_u8(bytes), vdupq_n_u8(byte));
+            mask &= count >= 16 ? ~std::uint64_t(0) : (std::uint64_t(1) << (4 * count)) - 1;
+            return mask ? lowestBit(mask) / 4 : count;
+#else
+            return findByte(bytes, count, byte);
+#endif
+        }
+
+        /**
+         * @brief Length of the common prefix of `a[0, length)` and `b[0, length)`.
+         */
+        inline std::size_t commonPrefixLength(const char* a, const char* b,
+                                              std::size_t length) noexcept {
+            auto* left = reinterpret_cast<const unsigned char*>(a);
+            auto* right = reinterpret_cast<const unsigned char*>(b);
+            std::size_t i = 0;
+#if defined(SEFN_SIMD_AVX2)
+            for (; i + 32 <= length; i += 32) {
+                __m256i x = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(left + i));
+                __m256i y = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(right + i));
+                unsigned equal =
+                    static_cast<unsigned>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(x, y)));
+                if (equal != 0xFFFFFFFFu) {
+                    return i + lowestBit(~equal);
+                }
+            }
+#endif
+#if defined(SEFN_SIMD_SSE2)
+            for (; i + 16 <= length; i += 16) {
+                __m128i y = _mm_loadu_si128(reinterpret_cast<const __m128i*>(right + i));
+                unsigned equal = equalMask16(left + i, y);
+                if (equal != 0xFFFFu) {
+                    return i + lowestBit(~equal & 0xFFFFu);
+                }
+            }
+#elif defined(SEFN_SIMD_NEON)
+            for (; i + 16 <= length; i += 16) {
+                std::uint64_t equal = equalNibbles16(vld1q_u8(left + i), vld1q_u8(right + i));
+                if (equal != ~std::uint64_t(0)) {
+                    return i + lowestBit(~equal) / 4;
+                }
+            }
+#endif
+            while (i < length && left[i] == right[i]) {
+                ++i;
+            }
+            return i;
+        }
+
+    } // namespace detail
+
+} // namespace Sefn
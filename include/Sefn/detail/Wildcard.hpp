@@ -0,0 +1,197 @@
+#pragma once
+
+#include <bitset>
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+#include <vector>
+
+/**
+ * @file Sefn/detail/Wildcard.hpp
+ * @brief Wildcard patterns compiled to a small NFA that tries step one character at a time.
+ */
+
+namespace Sefn {
+
+    namespace detail {
+
+        /**
+         * @class WildcardPattern
+         * @brief Glob-style pattern over `char` keys.
+         *
+         * @details Syntax:
+         * - `?` matches any single character, `*` any run of characters (including none).
+         * - `[abc]`, `[a-z]` match one character of the set; `[!...]` or `[^...]` negate it.
+         *   A `]` right after the opening bracket (or its negation) is part of the set; a `[`
+         *   without a closing `]` is a literal.
+         * - `\` makes the next character a literal.
+         *
+         * The pattern compiles to tokens; state `i` means "tokens before i are matched" and
+         * state size() accepts. A state set is an array of size() + 1 flags, so a walk keeps
+         * one such row per depth and a branch dies when its row is empty.
+         */
+        class WildcardPattern {
+        public:
+            explicit WildcardPattern(std::string_view pattern) {
+                for (std::size_t i = 0; i < pattern.size(); ++i) {
+                    char ch = pattern[i];
+                    if (ch == '*') {
+                        if (tokens.empty() || tokens.back().kind != Kind::Star) {
+                            tokens.push_back({Kind::Star, 0, 0});
+                        }
+                    } else if (ch == '?') {
+                        tokens.push_back({Kind::Any, 0, 0});
+                    } else if (ch == '[' && parseClass(pattern, i)) {
+                        // parseClass() consumed the class and advanced i
+                    } else {
+                        if (ch == '\\' && i + 1 < pattern.size()) {
+                            ch = pattern[++i];
+                        }
+                        tokens.push_back({Kind::Literal, ch, 0});
+                    }
+                }
+            }
+
+            /**
+             * @brief Number of tokens; the accepting state.
+             */
+            std::size_t size() const {
+                return tokens.size();
+            }
+
+            /**
+             * @brief Sets @p states to the start state and everything it reaches without input.
+             */
+            void start(unsigned char* states) const {
+                for (std::size_t i = 0; i <= tokens.size(); ++i) {
+                    states[i] = 0;
+                }
+                states[0] = 1;
+                close(states);
+            }
+
+            /**
+             * @brief Computes in @p to the states reached from @p from by reading @p ch.
+             * @return False if no state survives.
+             */
+            bool step(const unsigned char* from, char ch, unsigned char* to) const {
+                bool alive = false;
+                for (std::size_t i = 0; i <= tokens.size(); ++i) {
+                    to[i] = 0;
+                }
+                for (std::size_t i = 0; i < tokens.size(); ++i) {
+                    if (!from[i]) {
+                        continue;
+                    }
+                    if (tokens[i].kind == Kind::Star) {
+                        to[i] = 1;
+                        alive = true;
+                    } else if (matches(tokens[i], ch)) {
+                        to[i + 1] = 1;
+                        alive = true;
+                    }
+                }
+                close(to);
+                return alive;
+            }
+
+            /**
+             * @brief True if the only live state in @p states waits for the literal @p literal,
+             *        so a walk can look up that single child instead of scanning all of them.
+             */
+            bool singleLiteral(const unsigned char* states, char& literal) const {
+                std::size_t live = tokens.size() + 1;
+                for (std::size_t i = 0; i <= tokens.size(); ++i) {
+                    if (states[i]) {
+                        if (live != tokens.size() + 1) {
+                            return false;
+                        }
+                        live = i;
+                    }
+                }
+                if (live >= tokens.size() || tokens[live].kind != Kind::Literal) {
+                    return false;
+                }
+                literal = tokens[live].literal;
+                return true;
+            }
+
+        private:
+            enum class Kind : std::uint8_t { Literal, Any, Star, Class };
+
+            struct Token {
+                Kind kind;
+                char literal;
+                std::uint32_t classIndex;
+            };
+
+            std::vector<Token> tokens;
+            std::vector<std::bitset<256>> classes;
+
+            static std::size_t indexOf(char ch) {
+                return static_cast<unsigned char>(ch);
+            }
+
+            bool matches(const Token& token, char ch) const {
+                switch (token.kind) {
+                    case Kind::Literal: return token.literal == ch;
+                    case Kind::Any: return true;
+                    case Kind::Class: return classes[token.classIndex].test(indexOf(ch));
+                    case Kind::Star: break;
+                }
+                return false;
+            }
+
+            /**
+             * @brief Adds the states reachable by letting a `*` match nothing.
+             */
+            void close(unsigned char* states) const {
+                for (std::size_t i = 0; i < tokens.size(); ++i) {
+                    if (states[i] && tokens[i].kind == Kind::Star) {
+                        states[i + 1] = 1;
+                    }
+                }
+            }
+
+            /**
+             * @brief Parses the class opening at @p position; on success moves @p position to
+             *        its closing `]`.
+             */
+            bool parseClass(std::string_view pattern, std::size_t& position) {
+                std::size_t i = position + 1;
+                bool negate = i < pattern.size() && (pattern[i] == '!' || pattern[i] == '^');
+                if (negate) {
+                    ++i;
+                }
+                std::bitset<256> set;
+                std::size_t first = i;
+                for (; i < pattern.size(); ++i) {
+                    char low = pattern[i];
+                    if (low == ']' && i > first) {
+                        break;
+                    }
+                    char high = low;
+                    if (i + 2 < pattern.size() && pattern[i + 1] == '-' && pattern[i + 2] != ']') {
+                        high = pattern[i + 2];
+                        i += 2;
+                    }
+                    for (std::size_t ch = indexOf(low); ch <= indexOf(high); ++ch) {
+                        set.set(ch);
+                    }
+                }
+                if (i >= pattern.size()) {
+                    return false;
+                }
+                if (negate) {
+                    set.flip();
+                }
+                tokens.push_back({Kind::Class, 0, static_cast<std::uint32_t>(classes.size())});
+                classes.push_back(set);
+                position = i;
+                return true;
+            }
+        };
+
+    } // namespace detail
+
+} // namespace Sefn
@@ -0,0 +1,104 @@
+#include "TestUtils.hpp"
+#include <Sefn/ConcurrentTrie.hpp>
+#include <atomic>
+#include <string>
+#include <thread>
+#include <vector>
+
+int testSingleThreaded() {
+    printTestHeader("Single Threaded");
+    Sefn::ConcurrentTrie<std::string> trie;
+    std::vector<std::string> words = {"car", "cart", "cat", "dog"};
+    for (auto& word : words) {
+        trie.insert(&word, word);
+    }
+
+    ASSERT_EQUAL(*trie.wordExists("cart"), "cart");
+    ASSERT_TRUE(trie.wordExists("ca") == nullptr);
+    ASSERT_TRUE(trie.prefixExists("ca"));
+
+    auto results = trie.autoComplete("ca");
+    ASSERT_EQUAL(results.size(), 3);
+    ASSERT_EQUAL(*results[0], "car");
+    ASSERT_EQUAL(*results[1], "cart");
+    ASSERT_EQUAL(*results[2], "cat");
+    ASSERT_EQUAL(trie.autoComplete("ca", 2).size(), 2);
+
+    ASSERT_TRUE(trie.erase("cart"));
+    ASSERT_TRUE(!trie.erase("cart"));
+    ASSERT_TRUE(!trie.prefixExists("cart"));
+    ASSERT_TRUE(trie.wordExists("car") != nullptr);
+    ASSERT_TRUE(trie.erase("dog"));
+    ASSERT_TRUE(!trie.prefixExists("d"));
+
+    trie.clear();
+    ASSERT_EQUAL(trie.autoComplete("").size(), 0);
+    trie.insert(&words[0], "car");
+    ASSERT_TRUE(trie.wordExists("car") != nullptr);
+
+    printTestFooter("Single Threaded");
+    return 0;
+}
+
+int testReadersDuringWrites() {
+    printTestHeader("Readers During Writes");
+    Sefn::ConcurrentTrie<int> trie;
+    std::vector<int> values(200);
+    for (int i = 0; i < 200; ++i) {
+        values[i] = i;
+    }
+    // Stable keys that readers must always find
+    for (int i = 0; i < 100; ++i) {
+        trie.insert(&values[i], "stable/" + std::to_string(i));
+    }
+
+    std::atomic<bool> done{false};
+    std::atomic<int> failures{0};
+    std::vector<std::thread> readers;
+    for (int r = 0; r < 4; ++r) {
+        readers.emplace_back([&]() {
+            while (!done.load()) {
+                for (int i = 0; i < 100; ++i) {
+                    const int* found = trie.wordExists("stable/" + std::to_string(i));
+                    if (!found || *found != i) {
+                        failures.fetch_add(1);
+                    }
+                }
+                if (trie.autoComplete("stable/").size() != 100) {
+                    failures.fetch_add(1);
+                }
+                trie.autoComplete("churn/");
+            }
+        });
+    }
+
+    // Writer churns a separate key space, forcing edge arrays and nodes to be replaced
+    for (int round = 0; round < 200; ++round) {
+        for (int i = 100; i < 200; ++i) {
+            trie.insert(&values[i], "churn/" + std::to_string(i) + "/" + std::to_string(round));
+        }
+        for (int i = 100; i < 200; ++i) {
+            trie.erase("churn/" + std::to_string(i) + "/" + std::to_string(round));
+        }
+    }
+    done.store(true);
+    for (auto& reader : readers) {
+        reader.join();
+    }
+    trie.reclaim();
+
+    ASSERT_EQUAL(failures.load(), 0);
+    ASSERT_TRUE(!trie.prefixExists("churn/"));
+    ASSERT_EQUAL(trie.autoComplete("").size(), 100);
+
+    printTestFooter("Readers During Writes");
+    return 0;
+}
+
+int main() {
+    if (testSingleThreaded() != 0) return 1;
+    if (testReadersDuringWrites() != 0) return 1;
+
+    std::cout << "\nAll ConcurrentTrie tests passed!\n";
+    return 0;
+}
@@ -0,0 +1,138 @@
+#include "TestUtils.hpp"
+#include <Sefn/Dawg.hpp>
+#include <Sefn/Trie.hpp>
+#include <cstddef>
+#include <random>
+#include <string>
+#include <vector>
+
+int testBuildAndQuery() {
+    printTestHeader("Build and Query");
+    Sefn::Dawg none;
+    ASSERT_TRUE(none.empty());
+    ASSERT_TRUE(!none.wordExists(""));
+    ASSERT_TRUE(!none.prefixExists(""));
+    ASSERT_TRUE(none.autoComplete("").empty());
+
+    Sefn::DawgBuilder builder;
+    ASSERT_TRUE(builder.add(""));
+    ASSERT_TRUE(builder.add("car"));
+    ASSERT_TRUE(builder.add("card"));
+    ASSERT_TRUE(builder.add("care"));
+    ASSERT_TRUE(builder.add("dog"));
+    ASSERT_TRUE(!builder.add("cat"));  // Out of order
+    ASSERT_TRUE(!builder.add("dog"));  // Duplicate
+    ASSERT_EQUAL(builder.size(), 5u);
+
+    Sefn::Dawg dawg = builder.finish();
+    ASSERT_EQUAL(builder.size(), 0u);
+    ASSERT_EQUAL(dawg.size(), 5u);
+    ASSERT_TRUE(dawg.wordExists(""));
+    ASSERT_TRUE(dawg.wordExists("card"));
+    ASSERT_TRUE(!dawg.wordExists("ca"));
+    ASSERT_TRUE(!dawg.wordExists("cards"));
+    ASSERT_TRUE(dawg.prefixExists("ca"));
+    ASSERT_TRUE(!dawg.prefixExists("cb"));
+
+    ASSERT_EQUAL(dawg.indexOf(""), 0u);
+    ASSERT_EQUAL(dawg.indexOf("care"), 3u);
+    ASSERT_EQUAL(dawg.indexOf("dog"), 4u);
+    ASSERT_EQUAL(dawg.indexOf("do"), Sefn::Dawg::npos);
+    ASSERT_EQUAL(dawg.wordAt(2), "card");
+
+    ASSERT_TRUE(dawg.autoComplete("car") ==
+                std::vector<std::string>({"car", "card", "care"}));
+    ASSERT_TRUE(dawg.autoComplete("", 2) == std::vector<std::string>({"", "car"}));
+    std::vector<std::size_t> indices;
+    std::size_t visited = dawg.forEachCompletion("ca", [&](std::string_view word,
+                                                           std::size_t index) {
+        indices.push_back(dawg.indexOf(word) == index ? index : Sefn::Dawg::npos);
+    });
+    ASSERT_EQUAL(visited, 3u);
+    ASSERT_TRUE(indices == std::vector<std::size_t>({1, 2, 3}));
+
+    std::vector<std::string> all;
+    dawg.traverse([&all](std::string_view word) { all.emplace_back(word); });
+    ASSERT_TRUE(all == std::vector<std::string>({"", "car", "card", "care", "dog"}));
+
+    printTestFooter("Build and Query");
+    return 0;
+}
+
+int testSharedSuffixes() {
+    printTestHeader("Shared Suffixes");
+    // Every stem takes every ending, so all stems lead into one shared suffix graph
+    const char* stems[] = {"walk", "talk", "jump", "play", "work", "call", "pull", "push"};
+    const char* endings[] = {"", "s", "ed", "er", "ers", "ing", "ings"};
+    Sefn::Trie<int> trie;
+    int value = 0;
+    for (const char* stem : stems) {
+        for (const char* ending : endings) {
+            trie.insert(&value, std::string(stem) + ending);
+        }
+    }
+    Sefn::Dawg dawg = Sefn::compileDawg(trie);
+    ASSERT_EQUAL(dawg.size(), trie.size());
+
+    Sefn::TrieStats shape = trie.stats();
+    ASSERT_TRUE(dawg.stateCount() * 4 < shape.nodes);
+    ASSERT_TRUE(dawg.memoryBytes() * 10 < shape.totalBytes());
+
+    std::size_t index = 0;
+    for (const auto& entry : trie) {
+        ASSERT_EQUAL(dawg.indexOf(entry.first), index);
+        ASSERT_EQUAL(dawg.wordAt(index), std::string(entry.first));
+        ++index;
+    }
+    ASSERT_TRUE(dawg.autoComplete("pu", 3) ==
+                std::vector<std::string>({"pull", "pulled", "puller"}));
+    ASSERT_TRUE(!dawg.wordExists("walkeds"));
+
+    printTestFooter("Shared Suffixes");
+    return 0;
+}
+
+int testMatchesTrie() {
+    printTestHeader("Matches Trie");
+    std::mt19937 random(27);
+    Sefn::Trie<int> trie;
+    int value = 0;
+    for (int i = 0; i < 3000; ++i) {
+        std::string word(random() % 7, 'a');
+        for (char& ch : word) {
+            ch = static_cast<char>("abcd\xE9"[random() % 5]);  // One negative char value
+        }
+        trie.insert(&value, word);
+    }
+    Sefn::Dawg dawg = Sefn::compileDawg(trie);
+    ASSERT_EQUAL(dawg.size(), trie.size());
+    ASSERT_TRUE(dawg.stateCount() < trie.stats().nodes);
+
+    std::vector<std::string> keys;
+    for (const auto& entry : trie) {
+        keys.emplace_back(entry.first);
+    }
+    ASSERT_TRUE(dawg.autoComplete("") == keys);
+
+    for (int i = 0; i < 2000; ++i) {
+        std::string query(random() % 8, 'a');
+        for (char& ch : query) {
+            ch = static_cast<char>("abcde\xE9"[random() % 6]);
+        }
+        ASSERT_EQUAL(dawg.wordExists(query), trie.wordExists(query) != nullptr);
+        ASSERT_EQUAL(dawg.prefixExists(query), trie.prefixExists(query));
+        ASSERT_EQUAL(dawg.autoComplete(query, 5).size(), trie.autoComplete(query, 5).size());
+    }
+
+    printTestFooter("Matches Trie");
+    return 0;
+}
+
+int main() {
+    if (testBuildAndQuery() != 0) return 1;
+    if (testSharedSuffixes() != 0) return 1;
+    if (testMatchesTrie() != 0) return 1;
+
+    std::cout << "\nAll Dawg tests passed!\n";
+    return 0;
+}
@@ -0,0 +1,165 @@
+#include "TestUtils.hpp"
+#include <Sefn/FrozenTrie.hpp>
+#include <Sefn/MappedFile.hpp>
+#include <Sefn/Trie.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <vector>
+
+int testBuildAndQuery() {
+    printTestHeader("Build and Query");
+    Sefn::FrozenTrieBuilder<std::uint32_t> builder;
+    ASSERT_TRUE(builder.add("", 0));
+    ASSERT_TRUE(builder.add("car", 1));
+    ASSERT_TRUE(builder.add("card", 2));
+    ASSERT_TRUE(builder.add("care", 3));
+    ASSERT_TRUE(builder.add("dog", 4));
+    ASSERT_TRUE(!builder.add("cat", 5));  // Out of order
+    ASSERT_TRUE(!builder.add("dog", 6));  // Duplicate
+    ASSERT_EQUAL(builder.size(), 5u);
+
+    std::vector<char> image = builder.finish();
+    Sefn::FrozenTrie<std::uint32_t> frozen(image.data(), image.size());
+    ASSERT_TRUE(frozen.isOpen());
+    ASSERT_EQUAL(frozen.size(), 5u);
+
+    ASSERT_EQUAL(*frozen.wordExists(""), 0u);
+    ASSERT_EQUAL(*frozen.wordExists("card"), 2u);
+    ASSERT_EQUAL(*frozen.wordExists("dog"), 4u);
+    ASSERT_TRUE(frozen.wordExists("ca") == nullptr);
+    ASSERT_TRUE(frozen.wordExists("cards") == nullptr);
+    ASSERT_TRUE(frozen.prefixExists("ca"));
+    ASSERT_TRUE(!frozen.prefixExists("cb"));
+
+    std::vector<std::uint32_t> completions;
+    for (const std::uint32_t* payload : frozen.autoComplete("car")) {
+        completions.push_back(*payload);
+    }
+    ASSERT_TRUE(completions == std::vector<std::uint32_t>({1, 2, 3}));
+    ASSERT_EQUAL(frozen.autoComplete("", 2).size(), 2u);
+    ASSERT_EQUAL(frozen.payloadAt(3), 3u);
+
+    std::vector<std::uint32_t> all;
+    frozen.traverse([&all](std::uint32_t payload) { all.push_back(payload); });
+    ASSERT_TRUE(all == std::vector<std::uint32_t>({0, 1, 2, 3, 4}));
+
+    printTestFooter("Build and Query");
+    return 0;
+}
+
+int testRejectsBadImages() {
+    printTestHeader("Reject Bad Images");
+    Sefn::FrozenTrieBuilder<std::uint32_t> builder;
+    builder.add("word", 7);
+    std::vector<char> image = builder.finish();
+
+    Sefn::FrozenTrie<std::uint64_t> wrongPayload(image.data(), image.size());
+    ASSERT_TRUE(!wrongPayload.isOpen());
+    ASSERT_TRUE(wrongPayload.wordExists("word") == nullptr);
+
+    Sefn::FrozenTrie<std::uint32_t> truncated(image.data(), image.size() - 1);
+    ASSERT_TRUE(!truncated.isOpen());
+
+    std::vector<char> corrupt = image;
+    corrupt[0] = 'X';
+    Sefn::FrozenTrie<std::uint32_t> badMagic(corrupt.data(), corrupt.size());
+    ASSERT_TRUE(!badMagic.isOpen());
+    ASSERT_TRUE(!badMagic.prefixExists(""));
+
+    Sefn::FrozenTrie<std::uint32_t> valid(image.data(), image.size());
+    ASSERT_EQUAL(*valid.wordExists("word"), 7u);
+
+    // Consistent header over broken node records
+    Sefn::detail::FrozenHeader header;
+    std::memcpy(&header, image.data(), sizeof(header));
+    auto withNode = [&](std::uint32_t index, Sefn::detail::FrozenNode node) {
+        std::vector<char> broken = image;
+        std::memcpy(broken.data() + header.nodesOffset + index * sizeof(node), &node,
+                    sizeof(node));
+        return Sefn::FrozenTrie<std::uint32_t>(broken.data(), broken.size()).isOpen();
+    };
+    const std::uint32_t none = Sefn::detail::frozenNoPayload;
+    ASSERT_TRUE(!withNode(0, {1, 5, none}));     // Children past the table
+    ASSERT_TRUE(!withNode(0, {3, 1, none}));     // Skips records
+    ASSERT_TRUE(!withNode(1, {1, 1, none}));     // Its own child
+    ASSERT_TRUE(!withNode(4, {0, 0, 1}));        // Payload past the word count
+    ASSERT_TRUE(withNode(4, {99, 0, 0}));        // Leaf child index is ignored
+
+    // Offsets that wrap around 2^64
+    std::vector<char> wrapping = image;
+    header.labelsOffset = ~std::uint64_t(0) - 15;
+    std::memcpy(wrapping.data(), &header, sizeof(header));
+    ASSERT_TRUE(!Sefn::FrozenTrie<std::uint32_t>(wrapping.data(), wrapping.size()).isOpen());
+
+    Sefn::FrozenTrie<std::uint32_t> trusted;
+    ASSERT_TRUE(trusted.openTrusted(image.data(), image.size()));
+    ASSERT_TRUE(trusted.prefixExists("wor"));
+
+    printTestFooter("Reject Bad Images");
+    return 0;
+}
+
+int testFreezeAndMap() {
+    printTestHeader("Freeze and Map");
+    Sefn::Trie<int> trie;
+    std::vector<int> values(500);
+    for (int i = 0; i < 500; ++i) {
+        values[i] = i;
+        trie.insert(&values[i], "key" + std::to_string(i * 7919 % 1000));
+    }
+
+    auto image = Sefn::freeze<std::uint32_t>(trie, [](int* value) {
+        return static_cast<std::uint32_t>(*value);
+    });
+
+    std::string fileName = "frozen_trie_test.bin";
+    {
+        std::FILE* file = std::fopen(fileName.c_str(), "wb");
+        ASSERT_TRUE(file != nullptr);
+        ASSERT_EQUAL(std::fwrite(image.data(), 1, image.size(), file), image.size());
+        std::fclose(file);
+    }
+
+    Sefn::MappedFile mapped(fileName);
+    ASSERT_TRUE(mapped.isOpen());
+    ASSERT_EQUAL(mapped.size(), image.size());
+    Sefn::FrozenTrie<std::uint32_t> frozen(mapped.data(), mapped.size());
+    ASSERT_TRUE(frozen.isOpen());
+    ASSERT_EQUAL(frozen.size(), 500u);
+
+    for (const char* prefix : {"", "k", "key", "key1", "key99", "key500", "nope"}) {
+        std::vector<int*> expected = trie.autoComplete(prefix);
+        std::vector<const std::uint32_t*> actual = frozen.autoComplete(prefix);
+        ASSERT_EQUAL(actual.size(), expected.size());
+        for (std::size_t i = 0; i < expected.size(); ++i) {
+            ASSERT_EQUAL(static_cast<int>(*actual[i]), *expected[i]);
+        }
+        ASSERT_EQUAL(frozen.prefixExists(prefix), trie.prefixExists(prefix));
+    }
+    for (int i = 0; i < 1000; ++i) {
+        std::string word = "key" + std::to_string(i);
+        int* expected = trie.wordExists(word);
+        const std::uint32_t* actual = frozen.wordExists(word);
+        ASSERT_EQUAL(actual != nullptr, expected != nullptr);
+        if (expected) {
+            ASSERT_EQUAL(static_cast<int>(*actual), *expected);
+        }
+    }
+
+    mapped.close();
+    std::remove(fileName.c_str());
+    printTestFooter("Freeze and Map");
+    return 0;
+}
+
+int main() {
+    if (testBuildAndQuery() != 0) return 1;
+    if (testRejectsBadImages() != 0) return 1;
+    if (testFreezeAndMap() != 0) return 1;
+
+    std::cout << "\nAll FrozenTrie tests passed!\n";
+    return 0;
+}
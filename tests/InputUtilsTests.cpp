@@ -2,6 +2,8 @@
 #include <sstream>
 #include <string>
 #include <limits>
+#include <optional>
+#include <vector>
 #include "TestUtils.hpp"
 #include <Sefn/InputUtils.hpp>
 
@@ -128,11 +130,187 @@ int testStringInput() {
     return 0;
 }
 
+template<typename T>
+std::string sentinelText(const T& value) {
+    std::ostringstream out;
+    out << value;
+    return out.str();
+}
+
+// True if readValidatedInput accepts `line` as T, with the value in `value`
+template<typename T, typename Validator>
+bool acceptedInteractively(const std::string& line, const T& sentinel, Validator validator,
+                           T& value) {
+    std::string output = runWithInput(line + "\n" + sentinelText(sentinel) + "\n", [&]() {
+        value = Sefn::readValidatedInput<T>("", 0, validator, "V!", "F!");
+    });
+    return output.find("V!") == std::string::npos && output.find("F!") == std::string::npos;
+}
+
+template<typename T, typename Validator>
+int checkBulkMatchesInteractive(const std::vector<std::string>& lines, const T& sentinel,
+                                Validator validator) {
+    for (const std::string& line : lines) {
+        T expected{};
+        bool accepted = acceptedInteractively<T>(line, sentinel, validator, expected);
+        auto bulk = Sefn::readValidatedValues<T>(line, validator);
+        if (line.empty()) {
+            ASSERT_TRUE(bulk.values.empty() && bulk.errors.empty());  // No line at all
+            continue;
+        }
+        if (accepted != (bulk.values.size() == 1)) {
+            std::cerr << "FAIL: \"" << line << "\" accepted=" << accepted << "\n";
+            return 1;
+        }
+        if (accepted) {
+            ASSERT_TRUE(bulk.values[0] == expected);
+        } else {
+            ASSERT_EQUAL(bulk.errors.size(), 1u);
+            ASSERT_EQUAL(bulk.errors[0].line, 1u);
+        }
+    }
+    return 0;
+}
+
+int testBulkMatchesInteractive() {
+    printTestHeader("testBulkMatchesInteractive");
+
+    auto nonNegative = [](const int& v) { return v >= 0; };
+    if (checkBulkMatchesInteractive<int>({"42", "  7", "\t8", "-3", "+5", "12 ", "1x", "x1", "",
+                                          "99999999999", "0x10", "--1", "+-1", "+", "-", "007"},
+                                         1000, nonNegative) != 0) {
+        return 1;
+    }
+    if (checkBulkMatchesInteractive<double>({"1.5", ".5", "1.", "1e3", "1e", "inf", "nan",
+                                             "-0.25", "+2", "1e999", " 3.0", "3.0 ", "abc",
+                                             "-.5e-2", "1.5.5"},
+                                            12345.0, nullptr) != 0) {
+        return 1;
+    }
+    if (checkBulkMatchesInteractive<bool>({"0", "1", "2", "+1", "true", "00", " 1", "-0"}, true,
+                                          std::function<bool(const bool&)>()) != 0) {
+        return 1;
+    }
+    // The two cases where parseLine departs from operator>>, judged alike by both readers
+    if (checkBulkMatchesInteractive<unsigned>({"-1", "-0", "5", "+3"}, 7u, nullptr) != 0) {
+        return 1;
+    }
+    if (checkBulkMatchesInteractive<char>({"a", " b", "ab", "c ", "7"}, 'z', nullptr) != 0) {
+        return 1;
+    }
+    auto shortWord = [](const std::string& s) { return s.size() <= 5; };
+    if (checkBulkMatchesInteractive<std::string>({"hello", " hi", "a b", "x ", "toolong"},
+                                                 std::string("ok"), shortWord) != 0) {
+        return 1;
+    }
+
+    printTestFooter("testBulkMatchesInteractive");
+    return 0;
+}
+
+int testBulkErrorPositions() {
+    printTestHeader("testBulkErrorPositions");
+
+    auto result = Sefn::readValidatedValues<int>("10\nabc\n-5\n 7x\n\n20",
+                                                 [](int v) { return v >= 0; });
+    ASSERT_TRUE(result.values == std::vector<int>({10, 20}));
+    ASSERT_EQUAL(result.errors.size(), 4u);
+    ASSERT_TRUE(result.errors[0].kind == Sefn::InputError::Kind::Format);
+    ASSERT_EQUAL(result.errors[0].line, 2u);
+    ASSERT_EQUAL(result.errors[0].column, 1u);
+    ASSERT_EQUAL(result.errors[0].text, "abc");
+    ASSERT_TRUE(result.errors[1].kind == Sefn::InputError::Kind::Validation);
+    ASSERT_EQUAL(result.errors[1].line, 3u);
+    ASSERT_EQUAL(result.errors[2].line, 4u);
+    ASSERT_EQUAL(result.errors[2].column, 3u);
+    ASSERT_EQUAL(result.errors[3].line, 5u);
+
+    // A single character per line
+    auto letters = Sefn::readValidatedValues<char>("a\n b\nab\nc \n");
+    ASSERT_TRUE(letters.values == std::vector<char>({'a', 'b'}));
+    ASSERT_EQUAL(letters.errors.size(), 2u);
+    ASSERT_EQUAL(letters.errors[0].column, 2u);
+
+    // Either callback can stop the read
+    std::vector<long> values;
+    std::size_t accepted = Sefn::forEachValidatedValue<long>(
+        "1\n2\nx\n3\n", [&values](long v) { values.push_back(v); },
+        [](const Sefn::InputError&) { return false; });
+    ASSERT_EQUAL(accepted, 2u);
+    ASSERT_TRUE(values == std::vector<long>({1, 2}));
+    accepted = Sefn::forEachValidatedValue<long>(
+        "1\n2\n3", [](long v) { return v < 2; }, [](const Sefn::InputError&) {});
+    ASSERT_EQUAL(accepted, 2u);
+
+    printTestFooter("testBulkErrorPositions");
+    return 0;
+}
+
+int testStreamOverload() {
+    printTestHeader("testStreamOverload");
+
+    std::string input = "abc\n10\n20\n";
+    auto adult = [](const int& v) { return v >= 18; };
+    int legacy = 0;
+    std::string expectedOutput = runWithInput(input, [&]() {
+        legacy = Sefn::readValidatedInput<int>("Age: ", 1, adult, "Too young!\n", "Bad!\n");
+    });
+
+    std::istringstream in(input);
+    std::ostringstream out;
+    std::optional<int> age =
+        Sefn::readValidatedInput<int>(in, out, "Age: ", 1, adult, "Too young!\n", "Bad!\n");
+    ASSERT_TRUE(age.has_value());
+    ASSERT_EQUAL(*age, legacy);
+    ASSERT_EQUAL(out.str(), expectedOutput);
+
+    // End of input ends the read instead of retrying forever
+    ASSERT_TRUE(!Sefn::readValidatedInput<int>(in, out, "Age: ").has_value());
+
+    printTestFooter("testStreamOverload");
+    return 0;
+}
+
+int testSessions() {
+    printTestHeader("testSessions");
+
+    std::istringstream firstIn("1\nx\n2\n3\n");
+    std::istringstream secondIn("alice\nbob smith\nbob\n");
+    std::ostringstream firstOut;
+    std::ostringstream secondOut;
+    Sefn::InputSession first(firstIn, firstOut);
+    Sefn::InputSession second(secondIn, secondOut);
+
+    std::vector<int> numbers;
+    std::vector<std::string> names;
+    while (true) {
+        std::optional<int> number = Sefn::readValidatedInput<int>(first, "> ");
+        std::optional<std::string> name = Sefn::readValidatedInput<std::string>(
+            second, "name: ", 0, [](const std::string& s) { return s.size() > 1; });
+        if (!number || !name) {
+            break;
+        }
+        numbers.push_back(*number);
+        names.push_back(*name);
+    }
+    ASSERT_TRUE(numbers == std::vector<int>({1, 2}));  // "3" has no name left to pair with
+    ASSERT_TRUE(names == std::vector<std::string>({"alice", "bob"}));
+    ASSERT_EQUAL(firstOut.str(), "> > \tInvalid format. Please try again.\n> > ");
+    ASSERT_TRUE(secondOut.str().find("Invalid format") != std::string::npos);
+
+    printTestFooter("testSessions");
+    return 0;
+}
+
 int main() {
     if (testValidInteger() != 0) return 1;
     if (testValidationFailure() != 0) return 1;
     if (testFormatFailure() != 0) return 1;
     if (testStringInput() != 0) return 1;
+    if (testBulkMatchesInteractive() != 0) return 1;
+    if (testBulkErrorPositions() != 0) return 1;
+    if (testStreamOverload() != 0) return 1;
+    if (testSessions() != 0) return 1;
 
     std::cout << "\nAll InputUtils tests passed!\n";
     return 0;
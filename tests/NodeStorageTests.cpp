@@ -0,0 +1,121 @@
+#include "TestUtils.hpp"
+#include <Sefn/NodeStorage.hpp>
+#include <cstdint>
+#include <cstring>
+#include <map>
+#include <memory>
+
+int testPoolReuse() {
+    printTestHeader("Pool Reuse");
+    Sefn::PoolStorage pool;
+
+    void* first = pool.allocate(24, alignof(std::max_align_t));
+    pool.deallocate(first, 24, alignof(std::max_align_t));
+    void* second = pool.allocate(20, alignof(std::max_align_t));
+
+    // Same size class, so the freed block comes straight back
+    ASSERT_TRUE(first == second);
+    ASSERT_EQUAL(pool.slabCount(), 1);
+
+    printTestFooter("Pool Reuse");
+    return 0;
+}
+
+int testPoolSlabGrowth() {
+    printTestHeader("Pool Slab Growth");
+    Sefn::PoolStorage pool(Sefn::PoolStorage::maxPooledSize);
+
+    for (int i = 0; i < 1000; ++i) {
+        void* block = pool.allocate(64, 8);
+        ASSERT_TRUE(reinterpret_cast<std::uintptr_t>(block) % alignof(std::max_align_t) == 0);
+        std::memset(block, 0xAB, 64);
+    }
+    ASSERT_TRUE(pool.slabCount() > 1);
+
+    pool.release();
+    ASSERT_EQUAL(pool.slabCount(), 0);
+
+    printTestFooter("Pool Slab Growth");
+    return 0;
+}
+
+int testPoolLargeBlocks() {
+    printTestHeader("Pool Large Blocks");
+    Sefn::PoolStorage pool;
+
+    void* large = pool.allocate(Sefn::PoolStorage::maxPooledSize * 4, 8);
+    void* aligned = pool.allocate(32, 64);
+    ASSERT_TRUE(reinterpret_cast<std::uintptr_t>(aligned) % 64 == 0);
+    std::memset(large, 0, Sefn::PoolStorage::maxPooledSize * 4);
+
+    pool.deallocate(large, Sefn::PoolStorage::maxPooledSize * 4, 8);
+    // 'aligned' is left for release() to reclaim
+    ASSERT_EQUAL(pool.slabCount(), 0);
+
+    printTestFooter("Pool Large Blocks");
+    return 0;
+}
+
+int testStorageAllocator() {
+    printTestHeader("Storage Allocator");
+    Sefn::PoolStorage pool;
+    using Alloc = Sefn::StorageAllocator<std::pair<const int, int>, Sefn::PoolStorage>;
+    {
+        std::map<int, int, std::less<int>, Alloc> map{Alloc(&pool)};
+        for (int i = 0; i < 100; ++i) {
+            map[i] = i * i;
+        }
+        ASSERT_EQUAL(map[9], 81);
+    }
+    ASSERT_EQUAL(pool.slabCount(), 1);
+
+    printTestFooter("Storage Allocator");
+    return 0;
+}
+
+int testPoolAdopt() {
+    printTestHeader("Pool Adopt");
+    Sefn::PoolStorage pool;
+    auto arena = std::make_unique<Sefn::PoolStorage>();
+    Sefn::PoolStorage* arenaPointer = arena.get();
+    void* block = arena->allocate(32, 8);
+    pool.adopt(std::move(arena));
+    ASSERT_EQUAL(pool.slabCount(), 1);
+
+    // Blocks from the arena can be recycled through the adopting pool
+    pool.deallocate(block, 32, 8);
+    ASSERT_TRUE(pool.allocate(32, 8) == block);
+    arenaPointer->allocate(32, 8);  // The arena stays usable until release()
+    ASSERT_EQUAL(pool.slabCount(), 1);
+
+    // Large arena blocks freed through the adopting pool leave both block lists intact
+    void* first = arenaPointer->allocate(8000, 8);
+    void* second = arenaPointer->allocate(8000, 8);
+    void* own = pool.allocate(8000, 8);
+    pool.deallocate(second, 8000, 8);  // Head of the arena's list
+    pool.deallocate(own, 8000, 8);
+    arenaPointer->allocate(9000, 8);
+    pool.deallocate(first, 8000, 8);
+
+    pool.release();
+    ASSERT_EQUAL(pool.slabCount(), 0);
+
+    static_assert(Sefn::detail::IsThreadSafeStorage<Sefn::HeapStorage>::value, "");
+    static_assert(!Sefn::detail::IsThreadSafeStorage<Sefn::PoolStorage>::value, "");
+    static_assert(Sefn::detail::CanAdoptStorage<Sefn::PoolStorage>::value, "");
+    static_assert(!Sefn::detail::CanAdoptStorage<Sefn::HeapStorage>::value, "");
+
+    printTestFooter("Pool Adopt");
+    return 0;
+}
+
+int main() {
+    if (testPoolReuse() != 0) return 1;
+    if (testPoolSlabGrowth() != 0) return 1;
+    if (testPoolLargeBlocks() != 0) return 1;
+    if (testStorageAllocator() != 0) return 1;
+    if (testPoolAdopt() != 0) return 1;
+
+    std::cout << "\nAll NodeStorage tests passed!\n";
+    return 0;
+}
@@ -0,0 +1,196 @@
+#include "TestUtils.hpp"
+#include <Sefn/PersistentTrie.hpp>
+#include <atomic>
+#include <map>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+int testVersions() {
+    printTestHeader("Versions");
+    std::vector<std::string> words = {"car", "cart", "cat", "dog"};
+    Sefn::PersistentTrie<std::string> empty;
+    Sefn::PersistentTrie<std::string> trie;
+    for (auto& word : words) {
+        trie = trie.insert(&word, word);
+    }
+    ASSERT_TRUE(empty.empty());
+    ASSERT_EQUAL(trie.size(), 4);
+    ASSERT_EQUAL(*trie.wordExists("cart"), "cart");
+    ASSERT_TRUE(trie.wordExists("ca") == nullptr);
+    ASSERT_TRUE(trie.prefixExists("ca"));
+
+    auto results = trie.autoComplete("ca");
+    ASSERT_EQUAL(results.size(), 3);
+    ASSERT_EQUAL(*results[0], "car");
+    ASSERT_EQUAL(*results[1], "cart");
+    ASSERT_EQUAL(*results[2], "cat");
+    ASSERT_EQUAL(trie.autoComplete("ca", 2).size(), 2);
+    ASSERT_EQUAL(trie.forEachCompletion("", [](std::string*) { return false; }), 1);
+
+    // Old versions never change
+    Sefn::PersistentTrie<std::string> snapshot = trie;
+    ASSERT_TRUE(snapshot.sharesRootWith(trie));
+    Sefn::PersistentTrie<std::string> pruned = trie.erase("cart").erase("dog");
+    ASSERT_EQUAL(pruned.size(), 2);
+    ASSERT_TRUE(!pruned.prefixExists("cart"));
+    ASSERT_TRUE(!pruned.prefixExists("d"));
+    ASSERT_TRUE(pruned.wordExists("car") != nullptr);
+    ASSERT_EQUAL(snapshot.size(), 4);
+    ASSERT_TRUE(snapshot.wordExists("cart") != nullptr);
+    ASSERT_TRUE(snapshot.wordExists("dog") != nullptr);
+
+    // Unchanged results share the version
+    ASSERT_TRUE(trie.erase("missing").sharesRootWith(trie));
+    ASSERT_TRUE(trie.insert(&words[0], "car").sharesRootWith(trie));
+    ASSERT_TRUE(!trie.insert(&words[1], "car").sharesRootWith(trie));
+    ASSERT_EQUAL(trie.insert(&words[1], "car").size(), 4);
+    ASSERT_EQUAL(trie.insert(nullptr, "car").size(), 3);
+
+    // The empty word and erasing everything
+    std::string blank;
+    Sefn::PersistentTrie<std::string> withBlank = trie.insert(&blank, "");
+    ASSERT_TRUE(withBlank.wordExists("") == &blank);
+    ASSERT_TRUE(trie.wordExists("") == nullptr);
+    Sefn::PersistentTrie<std::string> none = withBlank;
+    for (auto& word : words) {
+        none = none.erase(word);
+    }
+    ASSERT_EQUAL(none.size(), 1);
+    none = none.erase("");
+    ASSERT_TRUE(none.empty());
+    ASSERT_TRUE(none.sharesRootWith(empty));
+    ASSERT_TRUE(!none.prefixExists(""));
+    ASSERT_EQUAL(withBlank.size(), 5);
+
+    Sefn::PersistentTrie<std::string> moved = std::move(withBlank);
+    ASSERT_EQUAL(moved.size(), 5);
+    ASSERT_TRUE(withBlank.empty());
+
+    printTestFooter("Versions");
+    return 0;
+}
+
+int testHistory() {
+    printTestHeader("History");
+    // Every intermediate version must keep matching the reference taken at that point
+    std::vector<int> values(64);
+    std::vector<Sefn::PersistentTrie<int>> versions{Sefn::PersistentTrie<int>()};
+    std::vector<std::map<std::string, int*>> references{{}};
+    unsigned state = 7;
+    for (int step = 0; step < 400; ++step) {
+        state = state * 1103515245u + 12345u;
+        std::string key;
+        for (unsigned length = (state >> 8) % 5, i = 0; i < length; ++i) {
+            key += static_cast<char>('a' + (state >> (12 + 2 * i)) % 3);
+        }
+        Sefn::PersistentTrie<int> next = versions.back();
+        std::map<std::string, int*> reference = references.back();
+        if ((state >> 24) % 3 == 0) {
+            next = next.erase(key);
+            reference.erase(key);
+        } else {
+            int* value = &values[(state >> 20) % values.size()];
+            next = next.insert(value, key);
+            reference[key] = value;
+        }
+        versions.push_back(std::move(next));
+        references.push_back(std::move(reference));
+    }
+
+    for (std::size_t v = 0; v < versions.size(); ++v) {
+        std::vector<int*> expected;
+        for (const auto& entry : references[v]) {
+            expected.push_back(entry.second);
+            ASSERT_TRUE(versions[v].wordExists(entry.first) == entry.second);
+        }
+        ASSERT_EQUAL(versions[v].size(), expected.size());
+        ASSERT_TRUE(versions[v].autoComplete("") == expected);
+    }
+
+    // Dropping versions out of order frees only what no remaining version uses
+    for (std::size_t v = 1; v < versions.size(); v += 2) {
+        versions[v] = Sefn::PersistentTrie<int>();
+    }
+    for (std::size_t v = 0; v < versions.size(); v += 2) {
+        ASSERT_EQUAL(versions[v].size(), references[v].size());
+        for (const auto& entry : references[v]) {
+            ASSERT_TRUE(versions[v].wordExists(entry.first) == entry.second);
+        }
+    }
+
+    printTestFooter("History");
+    return 0;
+}
+
+int testSnapshotsAcrossThreads() {
+    printTestHeader("Snapshots Across Threads");
+    std::vector<int> values(200);
+    Sefn::PersistentTrie<int> published;
+    for (int i = 0; i < 100; ++i) {
+        published = published.insert(&values[i], "stable/" + std::to_string(i));
+    }
+    std::mutex publishMutex;
+
+    std::atomic<bool> done{false};
+    std::atomic<int> failures{0};
+    std::vector<std::thread> readers;
+    for (int r = 0; r < 4; ++r) {
+        readers.emplace_back([&]() {
+            while (!done.load()) {
+                Sefn::PersistentTrie<int> snapshot;
+                {
+                    std::lock_guard<std::mutex> lock(publishMutex);
+                    snapshot = published;
+                }
+                // A snapshot is internally consistent: its size matches its contents
+                std::size_t seen = 0;
+                snapshot.traverse([&seen](int*) { ++seen; });
+                if (seen != snapshot.size() || snapshot.autoComplete("stable/").size() != 100) {
+                    ++failures;
+                }
+            }
+        });
+    }
+
+    Sefn::PersistentTrie<int> writer;
+    {
+        std::lock_guard<std::mutex> lock(publishMutex);
+        writer = published;
+    }
+    for (int round = 0; round < 50; ++round) {
+        for (int i = 100; i < 200; ++i) {
+            writer = writer.insert(&values[i], "churn/" + std::to_string(i));
+        }
+        {
+            std::lock_guard<std::mutex> lock(publishMutex);
+            published = writer;
+        }
+        for (int i = 100; i < 200; ++i) {
+            writer = writer.erase("churn/" + std::to_string(i));
+        }
+        std::lock_guard<std::mutex> lock(publishMutex);
+        published = writer;
+    }
+    done = true;
+    for (auto& reader : readers) {
+        reader.join();
+    }
+
+    ASSERT_EQUAL(failures.load(), 0);
+    ASSERT_EQUAL(published.size(), 100);
+    ASSERT_TRUE(!published.prefixExists("churn/"));
+
+    printTestFooter("Snapshots Across Threads");
+    return 0;
+}
+
+int main() {
+    if (testVersions() != 0) return 1;
+    if (testHistory() != 0) return 1;
+    if (testSnapshotsAcrossThreads() != 0) return 1;
+
+    std::cout << "\nAll PersistentTrie tests passed!\n";
+    return 0;
+}
@@ -0,0 +1,147 @@
+#include "TestUtils.hpp"
+#include <Sefn/RadixTrie.hpp>
+#include <Sefn/Trie.hpp>
+#include <string>
+#include <vector>
+
+int testInsertAndFind() {
+    printTestHeader("Insert and Find");
+    Sefn::RadixTrie<int> trie;
+    int a = 1, b = 2, c = 3;
+
+    trie.insert(&a, "/api/v1/users");
+    trie.insert(&b, "/api/v1/users/list");
+    trie.insert(&c, "/api/v1/items");
+
+    ASSERT_EQUAL(*trie.wordExists("/api/v1/users"), 1);
+    ASSERT_EQUAL(*trie.wordExists("/api/v1/users/list"), 2);
+    ASSERT_EQUAL(*trie.wordExists("/api/v1/items"), 3);
+    ASSERT_TRUE(trie.wordExists("/api/v1/") == nullptr);
+    ASSERT_TRUE(trie.wordExists("/api/v1/user") == nullptr);
+
+    ASSERT_TRUE(trie.prefixExists("/api/v1/u"));
+    ASSERT_TRUE(trie.prefixExists("/api"));
+    ASSERT_TRUE(!trie.prefixExists("/api/v2"));
+    ASSERT_TRUE(!trie.prefixExists("/api/v1/users/listing"));
+
+    printTestFooter("Insert and Find");
+    return 0;
+}
+
+int testSplitAndMerge() {
+    printTestHeader("Split and Merge");
+    Sefn::RadixTrie<std::string> trie;
+    std::string romane = "romane", romanus = "romanus", romulus = "romulus", rom = "rom";
+
+    trie.insert(&romane, "romane");
+    trie.insert(&romanus, "romanus");
+    trie.insert(&romulus, "romulus");
+    trie.insert(&rom, "rom");
+
+    auto results = trie.autoComplete("rom");
+    ASSERT_EQUAL(results.size(), 4);
+    ASSERT_EQUAL(*results[0], "rom");
+    ASSERT_EQUAL(*results[1], "romane");
+    ASSERT_EQUAL(*results[2], "romanus");
+    ASSERT_EQUAL(*results[3], "romulus");
+
+    auto limited = trie.autoComplete("rom", 2);
+    ASSERT_EQUAL(limited.size(), 2);
+    ASSERT_TRUE(limited[1] == results[1]);
+    ASSERT_EQUAL(trie.forEachCompletion("roma", [](std::string*) { return false; }), 1);
+
+    // Removing words merges edges back together
+    ASSERT_TRUE(trie.erase("romanus"));
+    ASSERT_TRUE(trie.erase("rom"));
+    ASSERT_TRUE(!trie.erase("rom"));
+    ASSERT_TRUE(!trie.erase("roman"));
+    ASSERT_EQUAL(*trie.wordExists("romane"), "romane");
+    ASSERT_EQUAL(*trie.wordExists("romulus"), "romulus");
+    ASSERT_TRUE(trie.prefixExists("roma"));
+
+    ASSERT_TRUE(trie.erase("romane"));
+    ASSERT_TRUE(trie.erase("romulus"));
+    ASSERT_TRUE(!trie.prefixExists("r"));
+    ASSERT_EQUAL(trie.autoComplete("").size(), 0);
+
+    printTestFooter("Split and Merge");
+    return 0;
+}
+
+int testMatchesTrie() {
+    printTestHeader("Matches Trie");
+    Sefn::RadixTrie<int, Sefn::PooledTrieTraits> radix;
+    Sefn::Trie<int> reference;
+    std::vector<int> values(2000);
+
+    unsigned seed = 12345;
+    auto next = [&seed]() { seed = seed * 1103515245u + 12345u; return seed >> 16; };
+    auto randomWord = [&next]() {
+        std::string word = "/p";
+        std::size_t length = next() % 6;
+        for (std::size_t i = 0; i < length; ++i) {
+            word += static_cast<char>('a' + next() % 3);
+        }
+        return word;
+    };
+
+    for (int i = 0; i < 2000; ++i) {
+        values[i] = i;
+        std::string word = randomWord();
+        if (next() % 3 == 0) {
+            ASSERT_EQUAL(radix.erase(word), reference.erase(word));
+        } else {
+            radix.insert(&values[i], word);
+            reference.insert(&values[i], word);
+        }
+    }
+
+    for (const char* prefix : {"", "/", "/p", "/pa", "/pab", "/pcc", "/pccc"}) {
+        auto expected = reference.autoComplete(prefix);
+        auto actual = radix.autoComplete(prefix);
+        ASSERT_TRUE(expected == actual);
+        ASSERT_EQUAL(radix.prefixExists(prefix), reference.prefixExists(prefix));
+        ASSERT_TRUE(radix.wordExists(prefix) == reference.wordExists(prefix));
+    }
+
+    printTestFooter("Matches Trie");
+    return 0;
+}
+
+int testLongLabels() {
+    printTestHeader("Long Labels");
+    // Edges longer than a vector register, diverging at every offset
+    Sefn::RadixTrie<int> trie;
+    const std::string stem(80, 's');
+    std::vector<std::string> words;
+    for (std::size_t i = 0; i <= stem.size(); i += 7) {
+        std::string word = stem;
+        word.insert(i, "x");
+        words.push_back(word);
+    }
+    std::vector<int> values(words.size());
+    for (std::size_t i = 0; i < words.size(); ++i) {
+        trie.insert(&values[i], words[i]);
+    }
+    for (std::size_t i = 0; i < words.size(); ++i) {
+        ASSERT_TRUE(trie.wordExists(words[i]) == &values[i]);
+        std::string shorter = words[i].substr(0, words[i].size() - 1);
+        ASSERT_TRUE(trie.wordExists(shorter) == nullptr);
+        ASSERT_TRUE(trie.prefixExists(shorter));
+    }
+    ASSERT_TRUE(trie.wordExists(stem + "s") == nullptr);
+    ASSERT_EQUAL(trie.autoComplete(stem.substr(0, 40)).size(), 6);  // x inserted at 42..77
+
+    printTestFooter("Long Labels");
+    return 0;
+}
+
+int main() {
+    if (testInsertAndFind() != 0) return 1;
+    if (testSplitAndMerge() != 0) return 1;
+    if (testMatchesTrie() != 0) return 1;
+    if (testLongLabels() != 0) return 1;
+
+    std::cout << "\nAll RadixTrie tests passed!\n";
+    return 0;
+}
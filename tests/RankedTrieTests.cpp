@@ -0,0 +1,112 @@
+#include "TestUtils.hpp"
+#include <Sefn/RankedTrie.hpp>
+#include <algorithm>
+#include <string>
+#include <utility>
+#include <vector>
+
+int testTopK() {
+    printTestHeader("Top K");
+    Sefn::RankedTrie<std::string, int> trie;
+    std::string phone = "phone", photo = "photo", phase = "phase", phrase = "phrase", dog = "dog";
+
+    trie.insert(&phone, "phone", 950);
+    trie.insert(&photo, "photo", 400);
+    trie.insert(&phase, "phase", 20);
+    trie.insert(&phrase, "phrase", 600);
+    trie.insert(&dog, "dog", 1000);
+
+    auto best = trie.topK("ph", 2);
+    ASSERT_EQUAL(best.size(), 2);
+    ASSERT_EQUAL(*best[0], "phone");
+    ASSERT_EQUAL(*best[1], "phrase");
+
+    auto all = trie.topK("", 10);
+    ASSERT_EQUAL(all.size(), 5);
+    ASSERT_EQUAL(*all[0], "dog");
+    ASSERT_EQUAL(*all[4], "phase");
+
+    ASSERT_EQUAL(trie.topK("x", 3).size(), 0);
+    ASSERT_EQUAL(trie.topK("ph", 0).size(), 0);
+
+    printTestFooter("Top K");
+    return 0;
+}
+
+int testScoreUpdates() {
+    printTestHeader("Score Updates");
+    Sefn::RankedTrie<std::string, int> trie;
+    std::string a = "apple", b = "apply", c = "ape";
+
+    trie.insert(&a, "apple", 10);
+    trie.insert(&b, "apply", 20);
+    trie.insert(&c, "ape", 5);
+    ASSERT_EQUAL(*trie.topK("ap", 1)[0], "apply");
+
+    // Lowering the best score must refresh cached maxima along the path
+    ASSERT_TRUE(trie.setScore("apply", 1));
+    ASSERT_EQUAL(*trie.topK("ap", 1)[0], "apple");
+    ASSERT_EQUAL(*trie.getScore("apply"), 1);
+    ASSERT_TRUE(!trie.setScore("missing", 3));
+
+    ASSERT_TRUE(trie.erase("apple"));
+    ASSERT_TRUE(!trie.erase("apple"));
+    ASSERT_EQUAL(*trie.topK("ap", 1)[0], "ape");
+    ASSERT_TRUE(!trie.getScore("apple").has_value());
+    ASSERT_TRUE(trie.prefixExists("appl"));
+
+    ASSERT_TRUE(trie.erase("apply"));
+    ASSERT_TRUE(!trie.prefixExists("app"));
+    ASSERT_EQUAL(trie.autoComplete("").size(), 1);
+
+    printTestFooter("Score Updates");
+    return 0;
+}
+
+int testMatchesSort() {
+    printTestHeader("Matches Sort");
+    Sefn::RankedTrie<int, int, Sefn::PooledTrieTraits> trie;
+    std::vector<std::pair<std::string, int>> entries;
+    std::vector<int> ids(500);
+
+    unsigned seed = 7;
+    auto next = [&seed]() { seed = seed * 1103515245u + 12345u; return seed >> 16; };
+    for (int i = 0; i < 500; ++i) {
+        ids[i] = i;
+        std::string word = "w";
+        for (int j = 0; j < 4; ++j) {
+            word += static_cast<char>('a' + next() % 4);
+        }
+        word += std::to_string(i);
+        int score = static_cast<int>(next() % 100000);
+        trie.insert(&ids[i], word, score);
+        entries.push_back({word, score});
+    }
+
+    for (const char* prefix : {"w", "wa", "wbc", "wddd"}) {
+        std::vector<int> expected;
+        for (auto const& [word, score] : entries) {
+            if (word.compare(0, std::string(prefix).size(), prefix) == 0) {
+                expected.push_back(score);
+            }
+        }
+        std::sort(expected.rbegin(), expected.rend());
+        auto top = trie.topK(prefix, 10);
+        ASSERT_EQUAL(top.size(), std::min<std::size_t>(10, expected.size()));
+        for (std::size_t i = 0; i < top.size(); ++i) {
+            ASSERT_EQUAL(entries[*top[i]].second, expected[i]);
+        }
+    }
+
+    printTestFooter("Matches Sort");
+    return 0;
+}
+
+int main() {
+    if (testTopK() != 0) return 1;
+    if (testScoreUpdates() != 0) return 1;
+    if (testMatchesSort() != 0) return 1;
+
+    std::cout << "\nAll RankedTrie tests passed!\n";
+    return 0;
+}
@@ -0,0 +1,124 @@
+#include "TestUtils.hpp"
+#include <Sefn/StaticTrie.hpp>
+#include <Sefn/Trie.hpp>
+#include <cstddef>
+#include <random>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace {
+
+    constexpr std::string_view httpMethods[] = {"GET",     "HEAD",    "POST",  "PUT",  "DELETE",
+                                                "CONNECT", "OPTIONS", "TRACE", "PATCH"};
+
+    constexpr auto methods = Sefn::makeStaticTrie<httpMethods>();
+
+    // Built entirely by the compiler
+    static_assert(methods.size() == 9);
+    static_assert(methods.indexOf("POST") == 2);
+    static_assert(methods.indexOf("PATCH") == 8);
+    static_assert(methods.indexOf("PO") == methods.npos);
+    static_assert(!methods.wordExists("get"));
+    static_assert(methods.prefixExists("PU"));
+    static_assert(!methods.prefixExists("X"));
+    static_assert(methods.wordAt(methods.indexOf("TRACE")) == "TRACE");
+
+    constexpr std::size_t countCompletions(std::string_view prefix) {
+        return methods.forEachCompletion(prefix, [](std::string_view, std::size_t) {});
+    }
+    static_assert(countCompletions("P") == 3);
+    static_assert(countCompletions("") == 9);
+
+    constexpr std::string_view nested[] = {"car", "", "card", "ca", "car", "cards", "b"};
+    constexpr auto nestedTrie = Sefn::makeStaticTrie<nested>();
+    static_assert(decltype(nestedTrie)::nodeCount() == 7);  // root, b, c, a, r, d, s
+    static_assert(nestedTrie.size() == 6);
+    static_assert(nestedTrie.indexOf("car") == 0);  // First of the duplicates
+    static_assert(nestedTrie.indexOf("") == 1);
+
+} // namespace
+
+int testCompileTimeTables() {
+    printTestHeader("Compile-Time Tables");
+    ASSERT_TRUE(methods.autoComplete("P") ==
+                std::vector<std::string_view>({"PATCH", "POST", "PUT"}));
+    ASSERT_TRUE(methods.autoComplete("", 2) ==
+                std::vector<std::string_view>({"CONNECT", "DELETE"}));
+    ASSERT_TRUE(methods.autoComplete("Z").empty());
+
+    ASSERT_TRUE(nestedTrie.autoComplete("") ==
+                std::vector<std::string_view>({"", "b", "ca", "car", "card", "cards"}));
+    std::vector<std::size_t> indices;
+    nestedTrie.forEachCompletion("car", [&indices](std::string_view, std::size_t index) {
+        indices.push_back(index);
+        return indices.size() < 2;
+    });
+    ASSERT_TRUE(indices == std::vector<std::size_t>({0, 2}));
+
+    // Runtime keys go through the same tables
+    std::string request = "OPTIONS /index.html";
+    ASSERT_EQUAL(methods.indexOf(std::string_view(request).substr(0, 7)), 6u);
+
+    printTestFooter("Compile-Time Tables");
+    return 0;
+}
+
+constexpr std::string_view sqlKeywords[] = {
+    "ADD",      "ALL",     "ALTER",     "AND",      "ANY",     "AS",       "ASC",
+    "BACKUP",   "BETWEEN", "BY",        "CASE",     "CHECK",   "COLUMN",   "CONSTRAINT",
+    "CREATE",   "DATABASE", "DEFAULT",  "DELETE",   "DESC",    "DISTINCT", "DROP",
+    "EXEC",     "EXISTS",  "FOREIGN",   "FROM",     "FULL",    "GROUP",    "HAVING",
+    "IN",       "INDEX",   "INNER",     "INSERT",   "INTO",    "IS",       "JOIN",
+    "KEY",      "LEFT",    "LIKE",      "LIMIT",    "NOT",     "NULL",     "OR",
+    "ORDER",    "OUTER",   "PRIMARY",   "PROCEDURE", "RIGHT",  "ROWNUM",   "SELECT",
+    "SET",      "TABLE",   "TOP",       "TRUNCATE", "UNION",   "UNIQUE",   "UPDATE",
+    "VALUES",   "VIEW",    "WHERE"};
+
+int testMatchesTrie() {
+    printTestHeader("Matches Trie");
+    constexpr auto keywords = Sefn::makeStaticTrie<sqlKeywords>();
+    Sefn::Trie<const std::string_view> trie;
+    for (const std::string_view& keyword : sqlKeywords) {
+        trie.insert(&keyword, keyword);
+    }
+    ASSERT_EQUAL(keywords.size(), trie.size());
+
+    std::mt19937 random(28);
+    for (int i = 0; i < 3000; ++i) {
+        std::string query;
+        if (i % 2 == 0) {
+            query = std::string(sqlKeywords[random() % std::size(sqlKeywords)]);
+            query.resize(random() % (query.size() + 2), 'E');
+        } else {
+            query.assign(random() % 4, 'A');
+            for (char& ch : query) {
+                ch = static_cast<char>('A' + random() % 26);
+            }
+        }
+        const std::string_view* expected = trie.wordExists(query);
+        std::size_t index = keywords.indexOf(query);
+        ASSERT_EQUAL(index != keywords.npos, expected != nullptr);
+        if (expected) {
+            ASSERT_TRUE(&sqlKeywords[index] == expected);
+        }
+        ASSERT_EQUAL(keywords.prefixExists(query), trie.prefixExists(query));
+
+        std::vector<std::string_view> completions;
+        for (const std::string_view* keyword : trie.autoComplete(query)) {
+            completions.push_back(*keyword);
+        }
+        ASSERT_TRUE(keywords.autoComplete(query) == completions);
+    }
+
+    printTestFooter("Matches Trie");
+    return 0;
+}
+
+int main() {
+    if (testCompileTimeTables() != 0) return 1;
+    if (testMatchesTrie() != 0) return 1;
+
+    std::cout << "\nAll StaticTrie tests passed!\n";
+    return 0;
+}
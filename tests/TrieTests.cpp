@@ -1,6 +1,17 @@
 #include "TestUtils.hpp"
 #include <Sefn/Trie.hpp>
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <iterator>
+#include <map>
+#include <memory>
+#include <stdexcept>
 #include <string>
+#include <string_view>
+#include <type_traits>
+#include <vector>
 
 int testInsertAndFind() {
     printTestHeader("Insert and Find");
@@ -93,11 +104,1498 @@ int testErase() {
     return 0;
 }
 
+int testEraseAll() {
+    printTestHeader("Erase All");
+    Sefn::Trie<int> trie;
+    int val = 1;
+    std::vector<std::string> words = {"", "a", "ab", "abc", "abd", "b", "ba", "bab"};
+    for (auto& word : words) {
+        trie.insert(&val, word);
+    }
+
+    // Prefix of a word erased first: its node must survive for the longer word
+    ASSERT_TRUE(trie.erase("ab"));
+    ASSERT_TRUE(trie.wordExists("abc") != nullptr);
+    ASSERT_TRUE(!trie.erase("ab"));
+
+    std::vector<std::string> batch = {"", "abc", "abd", "abz", "b", "bab", "zzz"};
+    ASSERT_EQUAL(trie.eraseAll(batch.begin(), batch.end()), 5u);
+    ASSERT_TRUE(trie.wordExists("") == nullptr);
+    ASSERT_TRUE(trie.wordExists("a") != nullptr);
+    ASSERT_TRUE(trie.wordExists("ba") != nullptr);
+    ASSERT_TRUE(!trie.prefixExists("ab"));
+    ASSERT_TRUE(!trie.prefixExists("bab"));
+
+    // Unsorted batches still remove everything they name
+    std::vector<const char*> rest = {"ba", "missing", "a"};
+    ASSERT_EQUAL(trie.eraseAll(rest.begin(), rest.end()), 2u);
+    ASSERT_TRUE(trie.autoComplete("").empty());
+    ASSERT_TRUE(!trie.prefixExists("a"));
+    ASSERT_TRUE(!trie.prefixExists("b"));
+
+    printTestFooter("Erase All");
+    return 0;
+}
+
+int testKeyViews() {
+    printTestHeader("Key Views");
+    Sefn::Trie<int> trie;
+    int a = 1, b = 2;
+    std::string buffer = "GET /index.html HTTP/1.1";
+    std::string_view path(buffer.data() + 4, 11);
+
+    trie.insert(&a, path);
+    trie.insert(&b, "GET");
+    ASSERT_EQUAL(*trie.wordExists("/index.html"), 1);
+    ASSERT_EQUAL(*trie.wordExists(std::string("GET")), 2);
+
+    std::vector<char> bytes = {'G', 'E', 'T'};
+    std::array<char, 3> fixed = {'G', 'E', 'T'};
+    ASSERT_EQUAL(*trie.wordExists(bytes), 2);
+    ASSERT_EQUAL(*trie.wordExists(fixed), 2);
+    ASSERT_TRUE(trie.prefixExists(std::string_view(buffer.data() + 4, 3)));
+    ASSERT_EQUAL(trie.autoComplete(std::string_view(buffer.data(), 1)).size(), 1u);
+
+    // String literals are C strings: the terminating '\0' is not part of the key
+    const char literal[] = "GET";
+    ASSERT_EQUAL(*trie.wordExists(literal), 2);
+
+    ASSERT_TRUE(trie.erase(bytes));
+    ASSERT_TRUE(trie.wordExists("GET") == nullptr);
+
+    printTestFooter("Key Views");
+    return 0;
+}
+
+struct TokenTraits : Sefn::TrieTraits {
+    using Key = std::uint32_t;
+    using Children = Sefn::SortedVectorChildren;
+};
+
+// Bits of an IPv4 prefix, most significant first
+std::vector<std::uint8_t> prefixBits(std::uint32_t address, int length) {
+    std::vector<std::uint8_t> bits;
+    for (int i = 0; i < length; ++i) {
+        bits.push_back(static_cast<std::uint8_t>((address >> (31 - i)) & 1u));
+    }
+    return bits;
+}
+
+int testKeyTypes() {
+    printTestHeader("Key Types");
+
+    // Token-ID sequences (n-grams)
+    Sefn::Trie<std::string, TokenTraits> ngrams;
+    std::string newYork = "new york", newYorkCity = "new york city", newJersey = "new jersey";
+    std::vector<std::uint32_t> tokensNY = {70000, 120};
+    std::vector<std::uint32_t> tokensNYC = {70000, 120, 5};
+    std::vector<std::uint32_t> tokensNJ = {70000, 99};
+    ngrams.insert(&newYork, tokensNY);
+    ngrams.insert(&newYorkCity, tokensNYC);
+    ngrams.insert(&newJersey, tokensNJ);
+    ASSERT_EQUAL(*ngrams.wordExists(tokensNYC), "new york city");
+    std::vector<std::uint32_t> prefix = {70000};
+    auto completions = ngrams.autoComplete(prefix);
+    ASSERT_EQUAL(completions.size(), 3u);
+    ASSERT_EQUAL(*completions[0], "new jersey");
+    auto it = ngrams.begin();
+    ASSERT_TRUE((*it).first == Sefn::BasicKeyView<std::uint32_t>(tokensNJ));
+    ASSERT_TRUE(ngrams.erase(tokensNY));
+    ASSERT_TRUE(ngrams.wordExists(tokensNYC) != nullptr);
+
+    // IPv4 routes as bit strings
+    Sefn::Trie<std::string, Sefn::BitTrieTraits> routes;
+    std::string lan = "lan", office = "office";
+    auto lanBits = prefixBits(0xC0A80000u, 16);    // 192.168.0.0/16
+    auto officeBits = prefixBits(0xC0A80A00u, 24); // 192.168.10.0/24
+    routes.insert(&lan, lanBits);
+    routes.insert(&office, officeBits);
+    ASSERT_EQUAL(*routes.wordExists(officeBits), "office");
+    ASSERT_TRUE(routes.prefixExists(prefixBits(0xC0A80A00u, 20)));
+    ASSERT_TRUE(!routes.prefixExists(prefixBits(0x0A000000u, 8)));
+    ASSERT_EQUAL(routes.autoComplete(lanBits).size(), 2u);
+    ASSERT_TRUE(routes.longestPrefixMatch(prefixBits(0xC0A80A05u, 32)).object == &office);
+    ASSERT_TRUE(routes.longestPrefixMatch(prefixBits(0xC0A80B05u, 32)).object == &lan);
+
+    // Nibbles and bytes iterate in numeric order
+    Sefn::Trie<int, Sefn::NibbleTrieTraits> nibbles;
+    int x = 1, y = 2;
+    std::vector<std::uint8_t> high = {15, 0}, low = {0, 15};
+    nibbles.insert(&x, high);
+    nibbles.insert(&y, low);
+    ASSERT_EQUAL(*nibbles.autoComplete(std::vector<std::uint8_t>())[0], 2);
+
+    // Elements outside a fixed alphabet are never stored, so queries with them find nothing
+    std::vector<std::uint8_t> wide = {15, 200};
+    ASSERT_TRUE(nibbles.wordExists(wide) == nullptr);
+    ASSERT_TRUE(!nibbles.prefixExists(wide));
+    ASSERT_TRUE(!nibbles.erase(wide));
+    ASSERT_TRUE(nibbles.autoComplete(wide).empty());
+    ASSERT_EQUAL(nibbles.size(), 2u);
+    std::vector<std::uint8_t> notBits = {1, 1, 0, 0, 2}, byteBits = {255};
+    ASSERT_TRUE(routes.wordExists(notBits) == nullptr);
+    ASSERT_TRUE(!routes.prefixExists(byteBits));
+    ASSERT_TRUE(!routes.erase(byteBits));
+    ASSERT_TRUE(routes.longestPrefixMatch(byteBits).object == nullptr);
+    ASSERT_EQUAL(routes.size(), 2u);
+
+    // ... and inserting them is rejected before any node is created
+    auto rejects = [](auto&& insertion) {
+        try {
+            insertion();
+        } catch (const std::invalid_argument&) {
+            return true;
+        }
+        return false;
+    };
+    std::size_t routeNodes = routes.stats().nodes;
+    ASSERT_TRUE(rejects([&] { routes.insert(&lan, notBits); }));
+    ASSERT_TRUE(rejects([&] { routes.insert(&lan, std::vector<std::uint8_t>{0, 0, 1, 255}); }));
+    std::vector<std::pair<std::vector<std::uint8_t>, std::string*>> routeEntries = {
+        {{0, 1}, &lan}, {{0, 1, 1, 7}, &lan}};
+    auto firstEntry = routeEntries.begin(), lastEntry = routeEntries.end();
+    ASSERT_TRUE(rejects([&] { routes.buildFromUnsorted(firstEntry, lastEntry); }));
+    ASSERT_TRUE(rejects([&] { routes.buildParallel(firstEntry, lastEntry, 2); }));
+    ASSERT_EQUAL(routes.stats().nodes, routeNodes);
+    ASSERT_TRUE(routes.wordExists(std::vector<std::uint8_t>{0, 1}) == nullptr);
+    ASSERT_TRUE(rejects([&] { routes.buildFromSorted(firstEntry, lastEntry); }));
+    ASSERT_TRUE(routes.wordExists(std::vector<std::uint8_t>{0, 1}) == &lan);  // Came first
+    ASSERT_EQUAL(routes.size(), 3u);
+    Sefn::TrieMap<int, Sefn::NibbleTrieTraits> nibbleMap;
+    ASSERT_TRUE(rejects([&] { nibbleMap.emplace(wide, 1); }));
+    ASSERT_TRUE(rejects([&] { nibbleMap.insertOrAssign(std::vector<std::uint8_t>{16}, 1); }));
+    ASSERT_EQUAL(nibbleMap.stats().nodes, 1u);
+
+    Sefn::Trie<int, Sefn::ByteTrieTraits> bytes;
+    std::vector<std::uint8_t> big = {200}, small = {3};
+    bytes.insert(&x, big);
+    bytes.insert(&y, small);
+    auto ordered = bytes.autoComplete(std::vector<std::uint8_t>());
+    ASSERT_EQUAL(*ordered[0], 2);
+    ASSERT_EQUAL(*ordered[1], 1);
+    ASSERT_TRUE(bytes.erase(big));
+    ASSERT_EQUAL(bytes.autoComplete(std::vector<std::uint8_t>()).size(), 1u);
+
+    printTestFooter("Key Types");
+    return 0;
+}
+
+int testPrefixesOf() {
+    printTestHeader("Prefixes Of");
+    Sefn::Trie<std::string> routes;
+    std::string root = "root", api = "api", users = "users", user = "user";
+    routes.insert(&root, "/");
+    routes.insert(&api, "/api/");
+    routes.insert(&users, "/api/users");
+    routes.insert(&user, "/api/users/");
+
+    auto match = routes.longestPrefixMatch("/api/users/42");
+    ASSERT_TRUE(match.object == &user);
+    ASSERT_EQUAL(match.length, 11u);
+    ASSERT_TRUE(routes.longestPrefixMatch("/api/usersettings").object == &users);
+    ASSERT_TRUE(routes.longestPrefixMatch("/about").object == &root);
+    ASSERT_TRUE(routes.longestPrefixMatch("api").object == nullptr);
+    ASSERT_TRUE(routes.longestPrefixMatch("").object == nullptr);
+
+    std::vector<std::string> seen;
+    std::size_t count = routes.forEachPrefixOf("/api/users/42", [&](std::string_view word, std::string* obj) {
+        seen.push_back(std::string(word) + "=" + *obj);
+    });
+    ASSERT_EQUAL(count, 4u);
+    ASSERT_TRUE(seen == std::vector<std::string>({"/=root", "/api/=api", "/api/users=users", "/api/users/=user"}));
+    count = routes.forEachPrefixOf("/api/users/42", [](std::string_view, std::string*) { return false; });
+    ASSERT_EQUAL(count, 1u);
+
+    // Batched form agrees with single lookups, sorted or not
+    std::vector<std::string> inputs = {"/", "/a", "/api/", "/api/users", "/api/users/1", "/api/x", "x", "/api/users/2"};
+    std::vector<decltype(match)> batch;
+    routes.longestPrefixMatch(inputs.begin(), inputs.end(), std::back_inserter(batch));
+    ASSERT_EQUAL(batch.size(), inputs.size());
+    for (std::size_t i = 0; i < inputs.size(); ++i) {
+        auto single = routes.longestPrefixMatch(inputs[i]);
+        ASSERT_TRUE(batch[i].object == single.object);
+        ASSERT_EQUAL(batch[i].length, single.length);
+    }
+
+    // The empty word prefixes everything
+    std::string any = "any";
+    routes.insert(&any, "");
+    ASSERT_TRUE(routes.longestPrefixMatch("x").object == &any);
+    ASSERT_EQUAL(routes.longestPrefixMatch("x").length, 0u);
+
+    printTestFooter("Prefixes Of");
+    return 0;
+}
+
+int testLookupBatch() {
+    printTestHeader("Lookup Batch");
+    Sefn::Trie<int, Sefn::PooledTrieTraits> trie;
+    std::vector<int> values(200);
+    std::vector<std::string> queries;
+    for (int i = 0; i < 200; ++i) {
+        values[i] = i;
+        std::string word = "k" + std::to_string(i * 37);
+        if (i % 3 != 0) {
+            trie.insert(&values[i], word);
+        }
+        queries.push_back(word);
+        queries.push_back(word + "x");
+    }
+    queries.push_back("");
+    queries.push_back("k");
+
+    std::vector<int*> results;
+    trie.lookupBatch(queries.begin(), queries.end(), std::back_inserter(results));
+    ASSERT_EQUAL(results.size(), queries.size());
+    for (std::size_t i = 0; i < queries.size(); ++i) {
+        ASSERT_TRUE(results[i] == trie.wordExists(queries[i]));
+    }
+
+    std::vector<Sefn::KeyView> views(queries.begin(), queries.begin() + 5);
+    int* spanResults[5];
+    trie.lookupBatch(views.data(), views.size(), spanResults);
+    for (std::size_t i = 0; i < 5; ++i) {
+        ASSERT_TRUE(spanResults[i] == results[i]);
+    }
+
+    printTestFooter("Lookup Batch");
+    return 0;
+}
+
+// Counts live instances so tests can check owned values are destroyed; atomic because
+// buildParallel() copies values from several threads
+struct Tracked {
+    static std::atomic<int> live;
+    int value;
+    explicit Tracked(int value) : value(value) { ++live; }
+    Tracked(const Tracked& other) : value(other.value) { ++live; }
+    Tracked& operator=(const Tracked& other) = default;
+    ~Tracked() { --live; }
+};
+std::atomic<int> Tracked::live{0};
+
+int testOwningValues() {
+    printTestHeader("Owning Values");
+    {
+        Sefn::TrieMap<Tracked> map;
+        auto [first, inserted] = map.emplace("apple", 1);
+        ASSERT_TRUE(inserted);
+        ASSERT_EQUAL(first->value, 1);
+        auto [again, insertedAgain] = map.emplace("apple", 2);
+        ASSERT_TRUE(!insertedAgain);
+        ASSERT_TRUE(again == first);
+        ASSERT_EQUAL(again->value, 1);
+
+        map.insertOrAssign("apple", Tracked(3));
+        ASSERT_EQUAL(map.wordExists("apple")->value, 3);
+        ASSERT_TRUE(map.wordExists("apple") == first);  // Assigned in place, not moved
+        map.emplace("app", 4);
+        map.emplace("banana", 5);
+        ASSERT_EQUAL(Tracked::live.load(), 3);
+
+        ASSERT_EQUAL(map.autoComplete("app").size(), 2u);
+        ASSERT_TRUE(map.erase("app"));
+        ASSERT_EQUAL(Tracked::live.load(), 2);
+        std::vector<const char*> gone = {"apple"};
+        ASSERT_EQUAL(map.eraseAll(gone.begin(), gone.end()), 1u);
+        ASSERT_EQUAL(Tracked::live.load(), 1);
+        ASSERT_TRUE(!map.prefixExists("a"));
+
+        std::vector<std::pair<std::string, Tracked>> bulk = {{"kiwi", Tracked(6)}, {"fig", Tracked(7)}};
+        map.buildFromUnsorted(bulk.begin(), bulk.end());
+        ASSERT_EQUAL(map.wordExists("fig")->value, 7);
+        ASSERT_EQUAL(Tracked::live.load(), 5);  // 3 in the map, 2 in bulk
+        map.clear();
+        ASSERT_EQUAL(Tracked::live.load(), 2);
+        map.emplace("date", 8);
+    }
+    ASSERT_EQUAL(Tracked::live.load(), 0);
+
+    // Pooled owning trie with non-trivial values must still run destructors
+    {
+        Sefn::TrieMap<Tracked, Sefn::PooledTrieTraits> pooled;
+        for (int i = 0; i < 50; ++i) {
+            pooled.emplace("w" + std::to_string(i), i);
+        }
+        ASSERT_EQUAL(Tracked::live.load(), 50);
+    }
+    ASSERT_EQUAL(Tracked::live.load(), 0);
+
+    Sefn::TrieMap<int, Sefn::PooledTrieTraits> ids;
+    ids.insertOrAssign("x", 1);
+    ++*ids.wordExists("x");
+    ASSERT_EQUAL(*ids.wordExists("x"), 2);
+    auto it = ids.begin();
+    ASSERT_TRUE((*it).first == "x");
+    ASSERT_EQUAL(*(*it).second, 2);
+
+    printTestFooter("Owning Values");
+    return 0;
+}
+
+int testParallelWalks() {
+    printTestHeader("Parallel Walks");
+    Sefn::Trie<int> trie;
+    std::vector<int> values(3000);
+    for (int i = 0; i < 3000; ++i) {
+        values[i] = i;
+        trie.insert(&values[i], std::to_string(i * 7919 % 10007));
+    }
+    trie.insert(&values[0], "");
+
+    for (const char* prefix : {"", "1", "42", "9999", "x"}) {
+        std::vector<int*> expected = trie.autoComplete(prefix);
+        for (std::size_t threads : {1u, 2u, 3u, 8u}) {
+            ASSERT_TRUE(trie.autoCompleteParallel(prefix, Sefn::ParallelOrder::Lexicographic,
+                                                  threads) == expected);
+            std::vector<int*> unordered =
+                trie.autoCompleteParallel(prefix, Sefn::ParallelOrder::Unordered, threads);
+            std::sort(unordered.begin(), unordered.end());
+            std::vector<int*> sortedExpected = expected;
+            std::sort(sortedExpected.begin(), sortedExpected.end());
+            ASSERT_TRUE(unordered == sortedExpected);
+        }
+    }
+    ASSERT_TRUE(trie.autoCompleteParallel("") == trie.autoComplete(""));
+
+    std::atomic<long> sum{0};
+    std::atomic<int> count{0};
+    trie.traverseParallel([&](int* value) {
+        sum += *value;
+        ++count;
+    }, 4);
+    ASSERT_EQUAL(count.load(), 3001);
+    ASSERT_EQUAL(sum.load(), 2999L * 3000 / 2);
+
+    bool thrown = false;
+    try {
+        trie.traverseParallel([](int* value) {
+            if (*value == 1234) {
+                throw std::runtime_error("stop");
+            }
+        }, 4);
+    } catch (const std::runtime_error&) {
+        thrown = true;
+    }
+    ASSERT_TRUE(thrown);
+
+    Sefn::Trie<int> empty;
+    ASSERT_TRUE(empty.autoCompleteParallel("").empty());
+    empty.traverseParallel([](int*) {}, 4);
+
+    printTestFooter("Parallel Walks");
+    return 0;
+}
+
+// Once armed, copies fail for one value, to check buildParallel() rolls back
+struct ThrowingCopy {
+    static bool armed;
+    int value;
+    explicit ThrowingCopy(int value) : value(value) {}
+    ThrowingCopy(const ThrowingCopy& other) : value(other.value) {
+        if (armed && value == 777) {
+            throw std::runtime_error("copy");
+        }
+    }
+    ThrowingCopy& operator=(const ThrowingCopy& other) = default;
+};
+bool ThrowingCopy::armed = false;
+
+// Same as HeapStorage but not marked thread-safe, so buildParallel() stays sequential
+struct PlainStorage : Sefn::HeapStorage {
+    static constexpr bool threadSafe = false;
+};
+
+struct PlainTraits : Sefn::TrieTraits {
+    using Storage = PlainStorage;
+};
+
+struct PooledVectorTraits : Sefn::PooledTrieTraits {
+    using Children = Sefn::SortedVectorChildren;
+};
+
+template<class TrieType>
+std::vector<std::pair<std::string, int*>> contentsOf(const TrieType& trie) {
+    std::vector<std::pair<std::string, int*>> contents;
+    for (auto entry : trie) {
+        contents.emplace_back(std::string(entry.first), entry.second);
+    }
+    return contents;
+}
+
+template<class Traits>
+int checkParallelBuild() {
+    std::vector<int> values(4000);
+    std::vector<std::pair<std::string, int*>> entries;
+    for (int i = 0; i < 4000; ++i) {
+        values[i] = i;
+        entries.emplace_back(std::to_string(i * 7919 % 2500), &values[i]);  // Repeats words
+    }
+    entries.emplace_back("", &values[0]);
+    entries.emplace_back("zebra", &values[1]);
+
+    Sefn::Trie<int, Traits> expected;
+    expected.buildFromUnsorted(entries.begin(), entries.end());
+    for (std::size_t threads : {1u, 2u, 5u}) {
+        Sefn::Trie<int, Traits> trie;
+        trie.insert(&values[2], "1");  // Existing subtree: its words are inserted afterwards
+        trie.insert(&values[3], "q");
+        trie.buildParallel(entries.begin(), entries.end(), threads);
+        ASSERT_TRUE(trie.wordExists("q") == &values[3]);
+        ASSERT_TRUE(trie.erase("q"));
+        ASSERT_TRUE(contentsOf(trie) == contentsOf(expected));
+
+        // Nodes from the worker arenas are erased and reused like any other
+        for (int i = 0; i < 2500; i += 2) {
+            ASSERT_TRUE(trie.erase(std::to_string(i)));
+        }
+        for (int i = 0; i < 2500; i += 2) {
+            trie.insert(&values[i], std::to_string(i) + "x");
+        }
+        ASSERT_TRUE(trie.wordExists("10x") == &values[10]);
+        ASSERT_TRUE(trie.wordExists("11") != nullptr);
+    }
+    return 0;
+}
+
+int testParallelBuild() {
+    printTestHeader("Parallel Build");
+    if (checkParallelBuild<Sefn::TrieTraits>() != 0) return 1;
+    if (checkParallelBuild<Sefn::PooledTrieTraits>() != 0) return 1;
+    if (checkParallelBuild<PooledVectorTraits>() != 0) return 1;
+    if (checkParallelBuild<PlainTraits>() != 0) return 1;
+
+    std::vector<std::pair<std::vector<std::uint8_t>, int>> bytes = {{{200, 1}, 1}, {{3}, 2}, {{200}, 3}};
+    Sefn::TrieMap<int, Sefn::ByteTrieTraits> byteMap;
+    byteMap.buildParallel(bytes.begin(), bytes.end(), 3);
+    ASSERT_EQUAL(*byteMap.wordExists(std::vector<std::uint8_t>{200, 1}), 1);
+    ASSERT_EQUAL(*byteMap.wordExists(std::vector<std::uint8_t>{200}), 3);
+
+    {
+        std::vector<std::pair<std::string, Tracked>> owned;
+        for (int i = 0; i < 300; ++i) {
+            owned.emplace_back("k" + std::to_string(i), Tracked(i));
+            owned.emplace_back(std::to_string(i), Tracked(i));
+        }
+        Sefn::TrieMap<Tracked, Sefn::PooledTrieTraits> map;
+        map.buildParallel(owned.begin(), owned.end(), 4);
+        ASSERT_EQUAL(map.wordExists("k42")->value, 42);
+        ASSERT_EQUAL(Tracked::live.load(), 1200);
+    }
+    ASSERT_EQUAL(Tracked::live.load(), 0);
+
+    {
+        // Nodes above PoolStorage::maxPooledSize are dedicated blocks owned by the worker
+        // arenas; erasing frees them through the Trie's pool
+        struct Large {
+            int id = 0;
+            char padding[5000] = {};
+        };
+        std::vector<std::pair<std::string, Large>> large(3000);
+        for (int i = 0; i < 3000; ++i) {
+            large[i].first = std::to_string(i * 7);
+            large[i].second.id = i;
+        }
+        Sefn::TrieMap<Large, Sefn::PooledTrieTraits> map;
+        map.buildParallel(large.begin(), large.end(), 4);
+        for (int i = 0; i < 3000; i += 3) {
+            ASSERT_TRUE(map.erase(std::to_string(i * 7)));
+        }
+        ASSERT_EQUAL(map.size(), 2000u);
+        ASSERT_EQUAL(map.wordExists("7")->id, 1);
+        ASSERT_TRUE(map.wordExists("21") == nullptr);
+        map.emplace("x", Large());
+        map.clear();
+        ASSERT_EQUAL(map.size(), 0u);
+    }
+
+    std::vector<std::pair<std::string, ThrowingCopy>> failing;
+    for (int i = 0; i < 1000; ++i) {
+        failing.emplace_back(std::to_string(i), ThrowingCopy(i));
+    }
+    Sefn::TrieMap<ThrowingCopy, Sefn::PooledTrieTraits> partial;
+    partial.emplace("5", ThrowingCopy(5));
+    ThrowingCopy::armed = true;
+    bool thrown = false;
+    try {
+        partial.buildParallel(failing.begin(), failing.end(), 4);
+    } catch (const std::runtime_error&) {
+        thrown = true;
+    }
+    ThrowingCopy::armed = false;
+    ASSERT_TRUE(thrown);
+    ASSERT_TRUE(partial.wordExists("5") != nullptr);
+    ASSERT_TRUE(!partial.prefixExists("1"));
+    ASSERT_TRUE(!partial.prefixExists("7"));
+
+    printTestFooter("Parallel Build");
+    return 0;
+}
+
+std::size_t levenshtein(const std::string& a, const std::string& b) {
+    std::vector<std::size_t> row(b.size() + 1);
+    for (std::size_t j = 0; j <= b.size(); ++j) row[j] = j;
+    for (std::size_t i = 1; i <= a.size(); ++i) {
+        std::size_t diagonal = row[0];
+        row[0] = i;
+        for (std::size_t j = 1; j <= b.size(); ++j) {
+            std::size_t above = row[j];
+            row[j] = std::min({row[j] + 1, row[j - 1] + 1, diagonal + (a[i - 1] != b[j - 1])});
+            diagonal = above;
+        }
+    }
+    return row[b.size()];
+}
+
+int testFuzzySearch() {
+    printTestHeader("Fuzzy Search");
+    std::vector<std::string> words = {"", "a", "apple", "apply", "ape", "maple", "applet",
+                                      "banana", "bandana", "band", "can", "cane", "crane"};
+    std::vector<int> values(words.size());
+    Sefn::Trie<int> trie;
+    for (std::size_t i = 0; i < words.size(); ++i) {
+        values[i] = static_cast<int>(i);
+        trie.insert(&values[i], words[i]);
+    }
+
+    for (const char* query : {"", "appel", "aple", "bannana", "cn", "zzzzzz"}) {
+        for (std::size_t maxDistance : {0u, 1u, 2u, 3u}) {
+            std::vector<std::pair<std::string, std::size_t>> expected;
+            for (auto entry : trie) {
+                std::size_t distance = levenshtein(std::string(entry.first), query);
+                if (distance <= maxDistance) {
+                    expected.emplace_back(std::string(entry.first), distance);
+                }
+            }
+            std::vector<std::pair<std::string, std::size_t>> actual;
+            for (const auto& match : trie.fuzzySearch(query, maxDistance)) {
+                actual.emplace_back(words[*match.object], match.distance);
+            }
+            ASSERT_TRUE(actual == expected);  // Same words, same (lexicographic) order
+        }
+    }
+
+    auto limited = trie.fuzzySearch("apple", 2, 2);
+    ASSERT_EQUAL(limited.size(), 2u);
+    ASSERT_EQUAL(words[*limited[0].object], std::string("ape"));
+    ASSERT_EQUAL(words[*limited[1].object], std::string("apple"));
+    ASSERT_EQUAL(limited[1].distance, 0u);
+    ASSERT_TRUE(trie.fuzzySearch("apple", 1, 0).empty());
+
+    std::size_t visited = trie.forEachFuzzyMatch("can", 1, [](int*, std::size_t distance) {
+        return distance > 0;  // Stop at the exact match
+    });
+    ASSERT_EQUAL(visited, 1u);  // "can" sorts before "cane"
+
+    printTestFooter("Fuzzy Search");
+    return 0;
+}
+
+// Reference matcher for '?' and '*' only
+bool globMatches(std::string_view pattern, std::string_view word) {
+    if (pattern.empty()) return word.empty();
+    if (pattern[0] == '*') {
+        for (std::size_t skip = 0; skip <= word.size(); ++skip) {
+            if (globMatches(pattern.substr(1), word.substr(skip))) return true;
+        }
+        return false;
+    }
+    return !word.empty() && (pattern[0] == '?' || pattern[0] == word[0]) &&
+           globMatches(pattern.substr(1), word.substr(1));
+}
+
+int testPatternSearch() {
+    printTestHeader("Pattern Search");
+    std::vector<std::string> words = {"", "a", "apple", "apply", "ample", "ape", "apex", "maple",
+                                      "app*", "net.rx", "net.tx", "net.tx.err", "disk0", "disk7"};
+    std::vector<int> values(words.size());
+    Sefn::Trie<int> trie;
+    for (std::size_t i = 0; i < words.size(); ++i) {
+        values[i] = static_cast<int>(i);
+        trie.insert(&values[i], words[i]);
+    }
+    auto keysOf = [&](std::string_view pattern) {
+        std::vector<std::string> keys;
+        trie.forEachMatch(pattern, [&keys](std::string_view key, int*) { keys.emplace_back(key); });
+        return keys;
+    };
+
+    for (const char* pattern : {"", "*", "a*", "ap?l*", "*e", "*p*e*", "?", "net.?x*", "**x", "a*p*"}) {
+        std::vector<std::string> expected;
+        for (auto entry : trie) {
+            if (globMatches(pattern, entry.first)) {
+                expected.emplace_back(entry.first);
+            }
+        }
+        ASSERT_TRUE(keysOf(pattern) == expected);  // Each word once, in key order
+    }
+
+    using Keys = std::vector<std::string>;
+    ASSERT_TRUE(keysOf("disk[0-5]") == Keys({"disk0"}));
+    ASSERT_TRUE(keysOf("disk[!0-5]") == Keys({"disk7"}));
+    ASSERT_TRUE(keysOf("ap[elp]*") == Keys({"ape", "apex", "app*", "apple", "apply"}));
+    ASSERT_TRUE(keysOf("net.[rt]x") == Keys({"net.rx", "net.tx"}));
+    ASSERT_TRUE(keysOf("app\\*") == Keys({"app*"}));
+    ASSERT_TRUE(keysOf("[ap").empty());  // Unclosed class: literal '['
+
+    std::vector<int*> limited = trie.matchPattern("ap*", 2);
+    ASSERT_EQUAL(limited.size(), 2u);
+    ASSERT_EQUAL(*limited[0], 5);  // "ape"
+    ASSERT_EQUAL(trie.forEachMatch("net.*", [](int*) { return false; }), 1u);
+
+    // Key-reconstructing traversal matches the iterator
+    std::vector<std::string> traversed;
+    trie.traverse([&traversed](std::string_view key, int*) { traversed.emplace_back(key); });
+    std::vector<std::string> iterated;
+    for (auto entry : trie) {
+        iterated.emplace_back(entry.first);
+    }
+    ASSERT_TRUE(traversed == iterated);
+    std::vector<std::string> completed;
+    std::size_t count = trie.forEachCompletion("net.t", [&completed](std::string_view key, int* value) {
+        completed.emplace_back(key);
+        return *value != 10;  // Stop after "net.tx"
+    });
+    ASSERT_EQUAL(count, 1u);
+    ASSERT_TRUE(completed == Keys({"net.tx"}));
+
+    Sefn::Trie<int, Sefn::ByteTrieTraits> bytes;
+    bytes.insert(&values[0], std::vector<std::uint8_t>{1, 2});
+    std::vector<std::uint8_t> byteKey;
+    bytes.traverse([&byteKey](Sefn::BasicKeyView<std::uint8_t> key, int*) {
+        byteKey.assign(key.begin(), key.end());
+    });
+    ASSERT_TRUE(byteKey == std::vector<std::uint8_t>({1, 2}));
+
+    printTestFooter("Pattern Search");
+    return 0;
+}
+
+template<class Traits>
+int checkSubtreeCounts() {
+    using Counted = Sefn::Trie<int, Sefn::CountingTraits<Traits>>;
+    std::vector<int> values(600);
+    Counted counted;
+    Sefn::Trie<int, Traits> plain;  // Reference
+    for (int i = 0; i < 600; ++i) {
+        values[i] = i;
+        std::string word = "k" + std::to_string(i * 7919 % 701);
+        if (i % 50 == 0) {
+            word.push_back(static_cast<char>(-3));  // Sorts before every ASCII sibling
+        }
+        counted.insert(&values[i], word);
+        plain.insert(&values[i], word);
+        if (i % 3 == 0) {
+            std::string gone = "k" + std::to_string(i * 31 % 701);
+            ASSERT_EQUAL(counted.erase(gone), plain.erase(gone));
+        }
+    }
+    counted.insert(&values[0], "");
+    plain.insert(&values[0], "");
+    counted.insert(&values[1], "k1");
+    plain.insert(&values[1], "k1");  // Overwrite: no new word
+    counted.insert(nullptr, "k2");
+    plain.erase("k2");
+    std::vector<const char*> batch = {"k3", "k4", "k5", "zz"};
+    std::size_t erased = plain.eraseAll(batch.begin(), batch.end());
+    ASSERT_EQUAL(counted.eraseAll(batch.begin(), batch.end()), erased);
+
+    std::vector<std::string> keys;
+    for (auto entry : plain) {
+        keys.emplace_back(entry.first);
+    }
+    ASSERT_EQUAL(counted.size(), keys.size());
+    ASSERT_EQUAL(plain.size(), keys.size());
+    for (const char* prefix : {"", "k", "k1", "k12", "k7", "x"}) {
+        ASSERT_EQUAL(counted.countPrefix(prefix), plain.autoComplete(prefix).size());
+        ASSERT_EQUAL(plain.countPrefix(prefix), plain.autoComplete(prefix).size());
+    }
+
+    auto before = [](const std::string& a, const std::string& b) {
+        return std::lexicographical_compare(a.begin(), a.end(), b.begin(), b.end());
+    };
+    for (std::size_t i = 0; i < keys.size(); ++i) {
+        ASSERT_EQUAL(counted.rank(keys[i]), i);
+        auto it = counted.select(i);
+        ASSERT_TRUE(it != counted.end());
+        ASSERT_TRUE(std::string((*it).first) == keys[i]);
+        ASSERT_TRUE((*it).second == plain.wordExists(keys[i]));
+        if (i + 1 < keys.size()) {
+            ++it;
+            ASSERT_TRUE(std::string((*it).first) == keys[i + 1]);
+        }
+    }
+    for (const char* missing : {"a", "k", "k10x", "k99999", "zz"}) {
+        std::size_t expected =
+            std::lower_bound(keys.begin(), keys.end(), std::string(missing), before) - keys.begin();
+        ASSERT_EQUAL(counted.rank(missing), expected);
+    }
+    ASSERT_TRUE(counted.select(keys.size()) == counted.end());
+
+    std::vector<std::pair<std::string, int*>> entries = {
+        {"b", &values[0]}, {"a", &values[1]}, {"b", &values[2]}};
+    Counted built;
+    built.buildParallel(entries.begin(), entries.end(), 2);
+    ASSERT_EQUAL(built.size(), 2u);
+    built.buildFromUnsorted(entries.begin(), entries.end());
+    ASSERT_EQUAL(built.size(), 2u);
+    built.clear();
+    ASSERT_EQUAL(built.size(), 0u);
+    return 0;
+}
+
+int testSubtreeCounts() {
+    printTestHeader("Subtree Counts");
+    if (checkSubtreeCounts<Sefn::TrieTraits>() != 0) return 1;
+    if (checkSubtreeCounts<Sefn::PooledTrieTraits>() != 0) return 1;
+    if (checkSubtreeCounts<PooledVectorTraits>() != 0) return 1;
+
+    Sefn::TrieMap<int, Sefn::CountingTraits<>> map;
+    map.emplace("one", 1);
+    map.emplace("two", 2);
+    map.emplace("one", 3);
+    ASSERT_EQUAL(map.size(), 2u);
+    ASSERT_EQUAL(*(*map.select(1)).second, 2);
+    map.erase("one");
+    ASSERT_EQUAL(map.rank("two"), 0u);
+
+    printTestFooter("Subtree Counts");
+    return 0;
+}
+
+int testStats() {
+    printTestHeader("Stats");
+    int value = 0;
+    Sefn::Trie<int> trie;
+    for (const char* word : {"a", "ab", "abc", "b", "xyz"}) {
+        trie.insert(&value, word);
+    }
+    Sefn::TrieStats stats = trie.stats();
+    ASSERT_EQUAL(stats.nodes, 8u);
+    ASSERT_EQUAL(stats.words, 5u);
+    ASSERT_TRUE(stats.fanout == std::vector<std::size_t>({3, 4, 0, 1}));
+    ASSERT_TRUE(stats.depth == std::vector<std::size_t>({1, 3, 2, 2}));
+    ASSERT_TRUE(stats.chains == std::vector<std::size_t>({0, 0, 1}));  // "x" -> "y"
+    ASSERT_TRUE(stats.nodeBytes > 0 && stats.nodeBytes % stats.nodes == 0);
+    ASSERT_EQUAL(stats.valueBytes, stats.nodes * sizeof(int*));
+    ASSERT_TRUE(stats.edgeBytes > 0);
+    ASSERT_EQUAL(stats.totalBytes(), stats.nodeBytes + stats.edgeBytes);
+
+    Sefn::TrieStats subtree = trie.stats("x");
+    ASSERT_EQUAL(subtree.nodes, 3u);
+    ASSERT_EQUAL(subtree.words, 1u);
+    ASSERT_TRUE(subtree.depth == std::vector<std::size_t>({1, 1, 1}));
+    ASSERT_EQUAL(trie.stats("q").nodes, 0u);
+
+    Sefn::Trie<int, Sefn::ByteTrieTraits> bytes;
+    bytes.insert(&value, std::vector<std::uint8_t>{1, 2});
+    ASSERT_EQUAL(bytes.stats().edgeBytes, 0u);  // Inline child slots
+    Sefn::TrieMap<double> owning;
+    owning.emplace("k", 1.0);
+    ASSERT_EQUAL(owning.stats().valueBytes, 2 * (sizeof(double*) + sizeof(double)));
+
+    Sefn::Trie<int, Sefn::InstrumentedTraits<Sefn::PooledTrieTraits>> counted;
+    counted.insert(&value, "abc");
+    counted.insert(&value, "abd");
+    ASSERT_EQUAL(counted.counters().allocations, 5u);  // The root, a, b, c and d
+    counted.wordExists("abc");
+    counted.prefixExists("zz");
+    ASSERT_EQUAL(counted.counters().lookups, 2u);
+    ASSERT_EQUAL(counted.counters().nodesVisited, 4u);  // 3 steps, then 1 failed step
+    std::vector<std::string> keys = {"abd", "a"};
+    std::vector<int*> found(2);
+    counted.lookupBatch(keys.begin(), keys.end(), found.begin());
+    ASSERT_EQUAL(counted.counters().lookups, 4u);
+    ASSERT_EQUAL(counted.counters().nodesVisited, 8u);
+    counted.erase("abd");
+    ASSERT_EQUAL(counted.counters().deallocations, 1u);
+    counted.resetCounters();
+    ASSERT_EQUAL(counted.counters().lookups, 0u);
+    std::vector<std::pair<std::string, int*>> entries = {{"q", &value}, {"qr", &value}};
+    counted.buildParallel(entries.begin(), entries.end(), 2);
+    counted.buildFromSorted(entries.begin(), entries.end());
+    ASSERT_EQUAL(counted.counters().allocations, 2u);
+
+    printTestFooter("Stats");
+    return 0;
+}
+
+// Every subtree count matches a full walk of that subtree
+template<class TrieType>
+bool countsConsistent(const TrieType& trie) {
+    for (auto entry : trie) {
+        std::string key(entry.first);
+        for (std::size_t length = 0; length <= key.size(); ++length) {
+            std::string prefix = key.substr(0, length);
+            if (trie.countPrefix(prefix) != trie.autoComplete(prefix).size()) {
+                return false;
+            }
+        }
+    }
+    return trie.size() == trie.autoComplete("").size();
+}
+
+template<class Traits>
+int checkMergeAndExtract() {
+    using Counted = Sefn::Trie<int, Sefn::CountingTraits<Traits>>;
+    std::vector<int> values(300);
+    auto storage = std::make_shared<typename Counted::Storage>();
+    std::vector<Counted> shards;
+    Counted expected;
+    for (int shard = 0; shard < 3; ++shard) {
+        shards.emplace_back(storage);
+    }
+    for (int i = 0; i < 300; ++i) {
+        std::string word = std::to_string(i * 37 % 211);
+        shards[i % 3].insert(&values[i], word);
+    }
+    shards[1].insert(&values[5], "");
+    for (const Counted& shard : shards) {
+        for (auto entry : shard) {
+            if (!expected.wordExists(entry.first)) {
+                expected.insert(entry.second, entry.first);  // merge() keeps the first value
+            }
+        }
+    }
+
+    Counted merged(storage);
+    for (Counted& shard : shards) {
+        merged.merge(std::move(shard));
+        ASSERT_EQUAL(shard.size(), 0u);
+        ASSERT_TRUE(!shard.prefixExists("1"));
+    }
+    ASSERT_TRUE(contentsOf(merged) == contentsOf(expected));
+    ASSERT_TRUE(countsConsistent(merged));
+
+    // Different storages: nodes are copied
+    Counted separate;
+    separate.insert(&values[0], "0");
+    separate.insert(&values[1], "zz");
+    merged.merge(std::move(separate));
+    ASSERT_TRUE(merged.wordExists("zz") == &values[1]);
+    ASSERT_TRUE(merged.wordExists("0") == expected.wordExists("0"));
+    ASSERT_EQUAL(separate.size(), 0u);
+    expected.insert(&values[1], "zz");
+    separate.insert(&values[2], "reused");
+    ASSERT_EQUAL(separate.size(), 1u);
+
+    // Extraction keeps full keys and prunes the emptied path
+    Counted ones = merged.extractSubtree("1");
+    ASSERT_TRUE(ones.getStorage() == merged.getStorage());
+    ASSERT_EQUAL(ones.size(), expected.countPrefix("1"));
+    Counted expectedOnes = expected.extractSubtree("1");
+    ASSERT_TRUE(contentsOf(ones) == contentsOf(expectedOnes));
+    ASSERT_TRUE(!merged.prefixExists("1"));
+    ASSERT_TRUE(countsConsistent(merged));
+    ASSERT_TRUE(countsConsistent(ones));
+    ASSERT_TRUE(contentsOf(merged) == contentsOf(expected));
+
+    merged.insert(&values[3], "zzz");
+    Counted deep = merged.extractSubtree("zzz");
+    ASSERT_EQUAL(deep.size(), 1u);
+    ASSERT_TRUE(merged.prefixExists("zz"));
+    ASSERT_TRUE(!merged.prefixExists("zzz"));
+    merged.erase("zz");
+    ASSERT_TRUE(!merged.prefixExists("z"));
+    ASSERT_EQUAL(merged.extractSubtree("missing").size(), 0u);
+
+    merged.merge(std::move(ones));
+    merged.merge(std::move(deep));
+    expected.merge(std::move(expectedOnes));
+    expected.insert(&values[3], "zzz");
+    expected.erase("zz");
+    std::vector<std::pair<std::string, int*>> all = contentsOf(merged);
+    ASSERT_TRUE(all == contentsOf(expected));
+    ASSERT_TRUE(countsConsistent(merged));
+
+    Counted everything = merged.extractSubtree("");
+    ASSERT_EQUAL(merged.size(), 0u);
+    ASSERT_TRUE(contentsOf(everything) == all);
+    ASSERT_TRUE(countsConsistent(everything));
+    return 0;
+}
+
+Sefn::Trie<int> makeTrie(int* value) {
+    Sefn::Trie<int> trie;
+    trie.insert(value, "built");
+    return trie;
+}
+
+int testMoveAndMerge() {
+    printTestHeader("Move And Merge");
+    int value = 1;
+    Sefn::Trie<int> built = makeTrie(&value);
+    ASSERT_TRUE(built.wordExists("built") == &value);
+
+    std::vector<Sefn::Trie<int>> tries;
+    for (int i = 0; i < 10; ++i) {
+        tries.push_back(makeTrie(&value));  // Relocates through the move constructor
+    }
+    ASSERT_TRUE(tries[0].wordExists("built") == &value);
+
+    Sefn::Trie<int> moved = std::move(built);
+    ASSERT_TRUE(moved.wordExists("built") == &value);
+    moved = std::move(tries[9]);
+    ASSERT_TRUE(moved.wordExists("built") == &value);
+    moved = std::move(moved);
+    ASSERT_TRUE(moved.wordExists("built") == &value);
+    built.clear();  // Revives a moved-from Trie
+    ASSERT_EQUAL(built.size(), 0u);
+    built.insert(&value, "again");
+    ASSERT_TRUE(built.wordExists("again") == &value);
+
+    if (checkMergeAndExtract<Sefn::TrieTraits>() != 0) return 1;
+    if (checkMergeAndExtract<Sefn::PooledTrieTraits>() != 0) return 1;
+    if (checkMergeAndExtract<PooledVectorTraits>() != 0) return 1;
+
+    // Splicing allocates nothing; owned values move across storages
+    using Instrumented = Sefn::Trie<int, Sefn::InstrumentedTraits<Sefn::PooledTrieTraits>>;
+    auto pool = std::make_shared<Sefn::PoolStorage>();
+    Instrumented left(pool), right(pool);
+    left.insert(&value, "apple");
+    right.insert(&value, "banana");
+    right.insert(&value, "boat");
+    left.resetCounters();
+    left.merge(std::move(right));
+    ASSERT_EQUAL(left.counters().allocations, 0u);
+    ASSERT_TRUE(left.wordExists("boat") == &value);
+
+    Sefn::TrieMap<std::string> names, more;
+    names.emplace("a", "first");
+    more.emplace("a", "second");
+    more.emplace("ab", std::string(100, 'x'));
+    names.merge(std::move(more));
+    ASSERT_EQUAL(*names.wordExists("a"), "first");
+    ASSERT_EQUAL(names.wordExists("ab")->size(), 100u);
+    ASSERT_EQUAL(more.size(), 0u);
+
+    Tracked::live = 0;
+    {
+        Sefn::TrieMap<Tracked> owned, other;
+        owned.emplace("x", 1);
+        other.emplace("x", 2);
+        other.emplace("y", 3);
+        owned.merge(std::move(other));
+        ASSERT_EQUAL(Tracked::live.load(), 2);
+        Sefn::TrieMap<Tracked> extracted = owned.extractSubtree("y");
+        ASSERT_EQUAL(Tracked::live.load(), 2);
+        ASSERT_EQUAL(owned.wordExists("x")->value, 1);
+        ASSERT_EQUAL(extracted.wordExists("y")->value, 3);
+    }
+    ASSERT_EQUAL(Tracked::live.load(), 0);
+
+    printTestFooter("Move And Merge");
+    return 0;
+}
+
+// Every word of the key universe gets the same answer from the index and the tree
+template<class Hashed, class Plain>
+bool sameLookups(const Hashed& hashed, const Plain& plain, const std::vector<std::string>& keys) {
+    std::vector<const int*> batch(keys.size());
+    hashed.lookupBatch(keys.begin(), keys.end(), batch.begin());
+    for (std::size_t i = 0; i < keys.size(); ++i) {
+        const int* expected = plain.wordExists(keys[i]);
+        if (hashed.wordExists(keys[i]) != expected || batch[i] != expected ||
+            (expected && !hashed.prefixExists(keys[i]))) {
+            return false;
+        }
+    }
+    return contentsOf(hashed) == contentsOf(plain);
+}
+
+template<class Traits>
+int checkHashedLookups() {
+    using Hashed = Sefn::Trie<int, Traits>;
+    std::vector<int> values(500);
+    std::vector<std::string> keys = {"", "z"};
+    for (int i = 0; i < 400; ++i) {
+        keys.push_back(std::to_string(i * 7919 % 613));
+    }
+    Hashed hashed;
+    Sefn::Trie<int> plain;
+    for (int i = 0; i < 400; ++i) {
+        int* value = i % 11 == 0 ? nullptr : &values[i];
+        hashed.insert(value, keys[i]);
+        plain.insert(value, keys[i]);
+        if (i % 3 == 0) {
+            const std::string& gone = keys[i * 5 % keys.size()];
+            ASSERT_EQUAL(hashed.erase(gone), plain.erase(gone));
+        }
+    }
+    ASSERT_TRUE(sameLookups(hashed, plain, keys));
+    std::vector<std::string> batch(keys.begin() + 50, keys.begin() + 150);
+    std::sort(batch.begin(), batch.end());
+    ASSERT_EQUAL(hashed.eraseAll(batch.begin(), batch.end()),
+                 plain.eraseAll(batch.begin(), batch.end()));
+    ASSERT_TRUE(sameLookups(hashed, plain, keys));
+
+    std::vector<std::pair<std::string, int*>> entries;
+    for (int i = 0; i < 300; ++i) {
+        entries.emplace_back(keys[(i * 13) % keys.size()], i % 7 == 0 ? nullptr : &values[i]);
+    }
+    hashed.buildFromUnsorted(entries.begin(), entries.end());
+    plain.buildFromUnsorted(entries.begin(), entries.end());
+    ASSERT_TRUE(sameLookups(hashed, plain, keys));
+    hashed.buildParallel(entries.begin(), entries.end(), 4);
+    plain.buildParallel(entries.begin(), entries.end(), 4);
+    ASSERT_TRUE(sameLookups(hashed, plain, keys));
+
+    // Structural operations carry the index along
+    Hashed ones = hashed.extractSubtree("1");
+    Sefn::Trie<int> plainOnes = plain.extractSubtree("1");
+    ASSERT_TRUE(sameLookups(hashed, plain, keys));
+    ASSERT_TRUE(sameLookups(ones, plainOnes, keys));
+    Hashed separate;
+    separate.insert(&values[1], "separate");
+    ones.merge(std::move(separate));
+    plainOnes.insert(&values[1], "separate");
+    hashed.merge(std::move(ones));
+    plain.merge(std::move(plainOnes));
+    ASSERT_TRUE(sameLookups(hashed, plain, keys));
+    ASSERT_TRUE(hashed.wordExists("separate") == &values[1]);
+    ASSERT_TRUE(ones.wordExists("separate") == nullptr);
+
+    Hashed moved = std::move(hashed);
+    ASSERT_TRUE(sameLookups(moved, plain, keys));
+    Hashed all = moved.extractSubtree("");
+    ASSERT_TRUE(moved.wordExists("z") == nullptr);
+    ASSERT_TRUE(sameLookups(all, plain, keys));
+    ASSERT_TRUE(all.stats().indexBytes > 0);
+    all.clear();
+    plain.clear();
+    ASSERT_TRUE(sameLookups(all, plain, keys));
+    ASSERT_EQUAL(all.stats().indexBytes, 0u);
+    return 0;
+}
+
+int testHashedLookups() {
+    printTestHeader("Hashed Lookups");
+    using Sefn::HashedTraits;
+    if (checkHashedLookups<HashedTraits<>>() != 0) return 1;
+    if (checkHashedLookups<HashedTraits<Sefn::PooledTrieTraits>>() != 0) return 1;
+    if (checkHashedLookups<Sefn::CountingTraits<HashedTraits<PooledVectorTraits>>>() != 0) return 1;
+
+    // Merging into a Trie that shares the storage splices subtrees and their entries
+    using Pooled = Sefn::Trie<int, HashedTraits<Sefn::PooledTrieTraits>>;
+    int value = 0;
+    auto pool = std::make_shared<Sefn::PoolStorage>();
+    Pooled left(pool), right(pool);
+    left.insert(&value, "ab");
+    right.insert(&value, "a");
+    right.insert(&value, "abc");
+    right.insert(&value, "b");
+    left.merge(std::move(right));
+    for (const char* word : {"a", "ab", "abc", "b"}) {
+        ASSERT_TRUE(left.wordExists(word) == &value);
+    }
+    ASSERT_TRUE(right.wordExists("b") == nullptr);
+    ASSERT_TRUE(left.erase("abc"));
+    ASSERT_TRUE(left.wordExists("abc") == nullptr);
+
+    Sefn::TrieMap<std::string, HashedTraits<>> names;
+    names.emplace("one", "1");
+    names.insertOrAssign("two", "2");
+    names.insertOrAssign("one", "uno");
+    ASSERT_EQUAL(*names.wordExists("one"), "uno");
+    ASSERT_TRUE(names.erase("two"));
+    ASSERT_TRUE(names.wordExists("two") == nullptr);
+
+    Sefn::Trie<int, HashedTraits<Sefn::ByteTrieTraits>> bytes;
+    std::vector<std::uint8_t> key = {0, 255, 7};
+    bytes.insert(&value, key);
+    ASSERT_TRUE(bytes.wordExists(key) == &value);
+    key.pop_back();
+    ASSERT_TRUE(bytes.wordExists(key) == nullptr);
+
+    using Counted = Sefn::Trie<int, Sefn::InstrumentedTraits<HashedTraits<>>>;
+    Counted counted;
+    counted.insert(&value, "longer word");
+    counted.resetCounters();
+    ASSERT_TRUE(counted.wordExists("longer word") == &value);
+    ASSERT_EQUAL(counted.counters().lookups, 1u);
+    ASSERT_EQUAL(counted.counters().nodesVisited, 0u);
+
+    printTestFooter("Hashed Lookups");
+    return 0;
+}
+
+int testSimdKernels() {
+    printTestHeader("SIMD Kernels");
+    std::vector<unsigned char> bytes(80);
+    for (std::size_t i = 0; i < bytes.size(); ++i) {
+        bytes[i] = static_cast<unsigned char>(i * 37 % 251);
+    }
+    for (std::size_t count = 0; count <= bytes.size(); ++count) {
+        for (std::size_t at = 0; at < bytes.size(); ++at) {
+            unsigned char needle = bytes[at];
+            std::size_t expected = std::find(bytes.begin(), bytes.begin() + count, needle) -
+                                   bytes.begin();
+            ASSERT_EQUAL(Sefn::detail::findByte(bytes.data(), count, needle), expected);
+        }
+        ASSERT_EQUAL(Sefn::detail::findByte(bytes.data(), count, 255), count);
+    }
+    // Bytes past count must be ignored even when they match
+    unsigned char block[16];
+    for (std::size_t count = 0; count <= 16; ++count) {
+        std::fill(block, block + 16, 0xAB);
+        for (std::size_t i = 0; i < count; ++i) {
+            block[i] = static_cast<unsigned char>(i);
+        }
+        ASSERT_EQUAL(Sefn::detail::findByteIn16(block, count, 0xAB), count);
+        if (count > 0) {
+            ASSERT_EQUAL(Sefn::detail::findByteIn16(block, count, count - 1), count - 1);
+        }
+    }
+    std::string left(100, 'q');
+    for (std::size_t length = 0; length <= left.size(); ++length) {
+        ASSERT_EQUAL(Sefn::detail::commonPrefixLength(left.data(), left.data(), length), length);
+        for (std::size_t diff = 0; diff < length; diff += 3) {
+            std::string right = left;
+            right[diff] = static_cast<char>(-1);
+            ASSERT_EQUAL(Sefn::detail::commonPrefixLength(left.data(), right.data(), length),
+                         diff);
+        }
+    }
+
+    printTestFooter("SIMD Kernels");
+    return 0;
+}
+
+int testPooledStorage() {
+    printTestHeader("Pooled Storage");
+    Sefn::Trie<int, Sefn::PooledTrieTraits> trie;
+    int values[3] = {1, 2, 3};
+
+    trie.insert(&values[0], "car");
+    trie.insert(&values[1], "cart");
+    trie.insert(&values[2], "dog");
+    ASSERT_EQUAL(*trie.wordExists("cart"), 2);
+    std::size_t slabs = trie.getStorage()->slabCount();
+
+    // Erased nodes are recycled by later insertions
+    for (int round = 0; round < 1000; ++round) {
+        ASSERT_TRUE(trie.erase("dog"));
+        trie.insert(&values[2], "dog");
+    }
+    ASSERT_EQUAL(trie.getStorage()->slabCount(), slabs);
+
+    trie.clear();
+    ASSERT_EQUAL(trie.getStorage()->slabCount(), 1);
+    ASSERT_TRUE(trie.wordExists("car") == nullptr);
+    ASSERT_TRUE(!trie.prefixExists("c"));
+
+    trie.insert(&values[0], "again");
+    ASSERT_EQUAL(*trie.wordExists("again"), 1);
+
+    printTestFooter("Pooled Storage");
+    return 0;
+}
+
+int testSharedStorage() {
+    printTestHeader("Shared Storage");
+    auto pool = std::make_shared<Sefn::PoolStorage>();
+    int a = 1, b = 2;
+    {
+        Sefn::Trie<int, Sefn::PooledTrieTraits> first(pool);
+        Sefn::Trie<int, Sefn::PooledTrieTraits> second(pool);
+        first.insert(&a, "alpha");
+        second.insert(&b, "beta");
+
+        // Clearing one trie must not disturb the other
+        first.clear();
+        ASSERT_TRUE(first.wordExists("alpha") == nullptr);
+        ASSERT_EQUAL(*second.wordExists("beta"), 2);
+    }
+    ASSERT_TRUE(pool.use_count() == 1);
+
+    printTestFooter("Shared Storage");
+    return 0;
+}
+
+int testIterator() {
+    printTestHeader("Iterator");
+    Sefn::Trie<std::string> trie;
+    std::vector<std::string> words = {"", "car", "cart", "carton", "cat", "catalog", "dog"};
+    for (auto& word : words) {
+        trie.insert(&word, word);
+    }
+
+    // Keys come back rebuilt, in order, and match the stored objects
+    std::size_t index = 0;
+    for (auto [key, object] : trie) {
+        ASSERT_EQUAL(std::string(key), words[index]);
+        ASSERT_EQUAL(*object, words[index]);
+        ++index;
+    }
+    ASSERT_EQUAL(index, words.size());
+
+    ASSERT_EQUAL(std::distance(trie.begin("ca"), trie.end()), 5);
+    ASSERT_TRUE(trie.begin("x") == trie.end());
+    // Keys live in the iterator's buffer, so the iterator only claims the input category
+    using Iterator = Sefn::Trie<std::string>::const_iterator;
+    using Category = std::iterator_traits<Iterator>::iterator_category;
+    static_assert(std::is_same_v<Category, std::input_iterator_tag>);
+    std::vector<std::string> copied;
+    std::transform(trie.begin("cat"), trie.end(), std::back_inserter(copied),
+                   [](const auto& entry) { return std::string(entry.first); });
+    ASSERT_TRUE(copied == std::vector<std::string>({"cat", "catalog"}));
+    auto found = std::find_if(trie.begin("c"), trie.end(),
+                              [](const auto& entry) { return entry.first.size() > 4; });
+    ASSERT_EQUAL(std::string((*found).first), "carton");
+
+    // Paginate two at a time through "ca", resuming from the last key seen
+    std::vector<std::string> paged;
+    std::string cursor = "ca";
+    while (true) {
+        auto it = trie.upperBound("ca", cursor);
+        std::size_t taken = 0;
+        for (; it != trie.end() && taken < 2; ++it, ++taken) {
+            paged.push_back(std::string((*it).first));
+        }
+        if (taken == 0) {
+            break;
+        }
+        cursor = paged.back();
+    }
+    ASSERT_EQUAL(paged.size(), 5);
+    ASSERT_EQUAL(paged[0], "car");
+    ASSERT_EQUAL(paged[4], "catalog");
+
+    // Cursors that are not stored keys
+    ASSERT_EQUAL(std::string((*trie.upperBound("", "cas")).first), "cat");
+    ASSERT_EQUAL(std::string((*trie.upperBound("", "cb")).first), "dog");
+    ASSERT_EQUAL(std::string((*trie.upperBound("c", "a")).first), "car");
+    ASSERT_TRUE(trie.upperBound("c", "d") == trie.end());
+    ASSERT_TRUE(trie.upperBound("", "dog") == trie.end());
+
+    printTestFooter("Iterator");
+    return 0;
+}
+
+int testDeepKeys() {
+    printTestHeader("Deep Keys");
+    Sefn::Trie<int, Sefn::PooledTrieTraits> trie;
+    int a = 1, b = 2;
+    std::string deep(200000, 'p');
+    trie.insert(&a, deep);
+    trie.insert(&b, deep + "q");
+
+    std::size_t count = 0;
+    trie.traverse([&count](int*) { ++count; });
+    ASSERT_EQUAL(count, 2);
+    ASSERT_EQUAL(trie.autoComplete(deep.substr(0, 10)).size(), 2);
+    ASSERT_EQUAL((*trie.begin()).first.size(), deep.size());
+
+    printTestFooter("Deep Keys");
+    return 0;
+}
+
+// Orders keys the way the Trie does: by std::less<char>, element by element
+struct CharOrder {
+    bool operator()(const std::string& a, const std::string& b) const {
+        return std::lexicographical_compare(a.begin(), a.end(), b.begin(), b.end());
+    }
+};
+
+int testBulkBuild() {
+    printTestHeader("Bulk Build");
+    std::vector<std::string> words;
+    for (int i = 0; i < 400; ++i) {
+        words.push_back("w" + std::to_string(i * 7919 % 1000));
+    }
+    words.push_back("");
+    words.push_back(std::string(1, static_cast<char>(-5)) + "neg");
+    std::vector<int> values(words.size());
+    std::map<std::string, int*, CharOrder> sorted;
+    for (std::size_t i = 0; i < words.size(); ++i) {
+        values[i] = static_cast<int>(i);
+        sorted[words[i]] = &values[i];
+    }
+
+    Sefn::Trie<int> expected;
+    for (auto& [word, value] : sorted) {
+        expected.insert(value, word);
+    }
+
+    Sefn::Trie<int, Sefn::PooledTrieTraits> fromSorted;
+    fromSorted.buildFromSorted(sorted.begin(), sorted.end());
+    ASSERT_TRUE(fromSorted.autoComplete("") == expected.autoComplete(""));
+    ASSERT_EQUAL(*fromSorted.wordExists(""), values[words.size() - 2]);
+
+    // Unsorted input, with a repeated word whose last object must win
+    std::vector<std::pair<std::string, int*>> shuffled;
+    for (std::size_t i = 0; i < words.size(); ++i) {
+        shuffled.emplace_back(words[i], &values[i]);
+    }
+    int replacement = -1;
+    shuffled.emplace_back(words[0], &replacement);
+    Sefn::Trie<int> fromUnsorted;
+    fromUnsorted.buildFromUnsorted(shuffled.begin(), shuffled.end());
+    ASSERT_EQUAL(*fromUnsorted.wordExists(words[0]), -1);
+    sorted[words[0]] = &replacement;
+    auto it = fromUnsorted.begin();
+    for (auto& [word, value] : sorted) {
+        ASSERT_TRUE(it != fromUnsorted.end());
+        ASSERT_TRUE((*it).first == word);
+        ASSERT_TRUE((*it).second == value);
+        ++it;
+    }
+    ASSERT_TRUE(it == fromUnsorted.end());
+
+    // Bulk-adding to a populated Trie keeps the existing words
+    int extra = 99;
+    std::vector<std::pair<const char*, int*>> more = {{"w1", &extra}, {"w10x", &extra}};
+    fromSorted.buildFromSorted(more.begin(), more.end());
+    ASSERT_EQUAL(*fromSorted.wordExists("w1"), 99);
+    ASSERT_EQUAL(*fromSorted.wordExists("w10x"), 99);
+    ASSERT_EQUAL(*fromSorted.wordExists(words[5]), values[5]);
+    std::size_t added = sorted.count("w1") ? 1 : 2;
+    ASSERT_EQUAL(fromSorted.autoComplete("").size(), sorted.size() + added);
+
+    printTestFooter("Bulk Build");
+    return 0;
+}
+
+int testBoundedAutoComplete() {
+    printTestHeader("Bounded Auto Complete");
+    Sefn::Trie<std::string> trie;
+    std::vector<std::string> words = {"car", "cart", "carton", "cat", "catalog", "dog"};
+    for (auto& word : words) {
+        trie.insert(&word, word);
+    }
+
+    auto full = trie.autoComplete("ca");
+    for (std::size_t limit = 0; limit <= full.size() + 1; ++limit) {
+        auto limited = trie.autoComplete("ca", limit);
+        ASSERT_EQUAL(limited.size(), std::min(limit, full.size()));
+        for (std::size_t i = 0; i < limited.size(); ++i) {
+            ASSERT_TRUE(limited[i] == full[i]);
+        }
+    }
+    ASSERT_EQUAL(trie.autoComplete("x", 3).size(), 0);
+
+    // Visitor that stops after two results
+    std::vector<std::string> seen;
+    std::size_t visited = trie.forEachCompletion("car", [&seen](std::string* word) {
+        seen.push_back(*word);
+        return seen.size() < 2;
+    });
+    ASSERT_EQUAL(visited, 2);
+    ASSERT_EQUAL(seen[0], "car");
+    ASSERT_EQUAL(seen[1], "cart");
+
+    // Visitor returning void sees everything
+    std::size_t count = 0;
+    ASSERT_EQUAL(trie.forEachCompletion("", [&count](std::string*) { ++count; }), words.size());
+    ASSERT_EQUAL(count, words.size());
+
+    printTestFooter("Bounded Auto Complete");
+    return 0;
+}
+
+template<class Children>
+struct ChildrenTraits : Sefn::PooledTrieTraits {
+    using Children = Children;
+};
+
+template<class Children>
+int checkChildrenPolicy(const std::string& name) {
+    printTestHeader("Children Policy " + name);
+    Sefn::Trie<std::string, ChildrenTraits<Children>> trie;
+    std::map<std::string, std::string, CharOrder> reference;
+
+    // Dense root (all 256 byte values, including negative chars) plus sparse chains
+    std::vector<std::string> words;
+    for (int c = 0; c < 256; ++c) {
+        words.push_back(std::string(1, static_cast<char>(c)) + "x");
+    }
+    for (int i = 0; i < 300; ++i) {
+        words.push_back("key" + std::to_string(i * 7919 % 1000));
+    }
+    std::vector<std::string> values(words.begin(), words.end());
+    for (std::size_t i = 0; i < words.size(); ++i) {
+        trie.insert(&values[i], words[i]);
+        reference[words[i]] = words[i];
+    }
+
+    auto results = trie.autoComplete("");
+    ASSERT_EQUAL(results.size(), reference.size());
+    std::size_t index = 0;
+    for (auto const& [key, value] : reference) {
+        ASSERT_EQUAL(*results[index++], value);
+        ASSERT_TRUE(trie.wordExists(key) != nullptr);
+    }
+    std::size_t withPrefix = 0;
+    for (auto const& [key, value] : reference) {
+        withPrefix += key.compare(0, 4, "key1") == 0;
+    }
+    ASSERT_EQUAL(trie.autoComplete("key1").size(), withPrefix);
+
+    // Batched walks agree with single lookups
+    std::vector<std::string> queries(words.begin(), words.end());
+    queries.push_back("key");
+    queries.push_back("keyz");
+    std::vector<std::string*> batch(queries.size());
+    trie.lookupBatch(queries.begin(), queries.end(), batch.begin());
+    for (std::size_t i = 0; i < queries.size(); ++i) {
+        ASSERT_TRUE(batch[i] == trie.wordExists(queries[i]));
+    }
+
+    // Shrink every node back down, checking order along the way
+    for (int c = 0; c < 256; c += 2) {
+        std::string word = std::string(1, static_cast<char>(c)) + "x";
+        ASSERT_TRUE(trie.erase(word));
+        reference.erase(word);
+    }
+    results = trie.autoComplete("");
+    ASSERT_EQUAL(results.size(), reference.size());
+    index = 0;
+    for (auto const& [key, value] : reference) {
+        ASSERT_EQUAL(*results[index++], value);
+    }
+    ASSERT_TRUE(!trie.prefixExists(std::string(1, 'b')));
+    ASSERT_TRUE(trie.prefixExists(std::string(1, 'a')));
+
+    printTestFooter("Children Policy " + name);
+    return 0;
+}
+
+int testChildrenPolicies() {
+    if (checkChildrenPolicy<Sefn::MapChildren>("Map") != 0) return 1;
+    if (checkChildrenPolicy<Sefn::SortedVectorChildren>("SortedVector") != 0) return 1;
+    if (checkChildrenPolicy<Sefn::DirectChildren>("Direct") != 0) return 1;
+    if (checkChildrenPolicy<Sefn::AdaptiveChildren>("Adaptive") != 0) return 1;
+    if (checkChildrenPolicy<Sefn::FixedArrayChildren<256>>("FixedArray256") != 0) return 1;
+    return 0;
+}
+
 int main() {
     if (testInsertAndFind() != 0) return 1;
     if (testPrefixExists() != 0) return 1;
     if (testAutoComplete() != 0) return 1;
     if (testErase() != 0) return 1;
+    if (testEraseAll() != 0) return 1;
+    if (testKeyViews() != 0) return 1;
+    if (testKeyTypes() != 0) return 1;
+    if (testPrefixesOf() != 0) return 1;
+    if (testLookupBatch() != 0) return 1;
+    if (testOwningValues() != 0) return 1;
+    if (testParallelWalks() != 0) return 1;
+    if (testParallelBuild() != 0) return 1;
+    if (testFuzzySearch() != 0) return 1;
+    if (testPatternSearch() != 0) return 1;
+    if (testSubtreeCounts() != 0) return 1;
+    if (testStats() != 0) return 1;
+    if (testMoveAndMerge() != 0) return 1;
+    if (testHashedLookups() != 0) return 1;
+    if (testSimdKernels() != 0) return 1;
+    if (testBoundedAutoComplete() != 0) return 1;
+    if (testIterator() != 0) return 1;
+    if (testDeepKeys() != 0) return 1;
+    if (testBulkBuild() != 0) return 1;
+    if (testPooledStorage() != 0) return 1;
+    if (testSharedStorage() != 0) return 1;
+    if (testChildrenPolicies() != 0) return 1;
     
     std::cout << "\nAll Trie tests passed!\n";
     return 0;